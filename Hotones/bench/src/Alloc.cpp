@@ -0,0 +1,68 @@
+#include "Bench.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+#include <new>
+
+// ---------------------------------------------------------------------------
+// Global operator new / delete replacements that count heap allocations, so
+// every case can report allocations per entity next to its timing.
+// ---------------------------------------------------------------------------
+
+namespace {
+    std::atomic<uint64_t> g_allocs{ 0 };
+
+    void* Allocate(std::size_t size) {
+        g_allocs.fetch_add(1, std::memory_order_relaxed);
+        if (void* p = std::malloc(size ? size : 1)) return p;
+        throw std::bad_alloc();
+    }
+
+    void* AllocateAligned(std::size_t size, std::align_val_t align) {
+        g_allocs.fetch_add(1, std::memory_order_relaxed);
+        const std::size_t a = static_cast<std::size_t>(align);
+#if defined(_WIN32)
+        if (void* p = _aligned_malloc(size ? size : 1, a)) return p;
+#else
+        // aligned_alloc wants size to be a multiple of the alignment.
+        if (void* p = std::aligned_alloc(a, (size + a - 1) / a * a)) return p;
+#endif
+        throw std::bad_alloc();
+    }
+
+    void FreeAligned(void* p) noexcept {
+#if defined(_WIN32)
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+}
+
+namespace Hotones::Bench {
+    uint64_t AllocationCount() noexcept { return g_allocs.load(std::memory_order_relaxed); }
+}
+
+void* operator new  (std::size_t size)                         { return Allocate(size); }
+void* operator new[](std::size_t size)                         { return Allocate(size); }
+void* operator new  (std::size_t size, std::align_val_t align) { return AllocateAligned(size, align); }
+void* operator new[](std::size_t size, std::align_val_t align) { return AllocateAligned(size, align); }
+
+void* operator new  (std::size_t size, const std::nothrow_t&) noexcept {
+    try { return Allocate(size); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return Allocate(size); } catch (...) { return nullptr; }
+}
+
+void operator delete  (void* p) noexcept                                   { std::free(p); }
+void operator delete[](void* p) noexcept                                   { std::free(p); }
+void operator delete  (void* p, std::size_t) noexcept                      { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept                      { std::free(p); }
+void operator delete  (void* p, std::align_val_t) noexcept                 { FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept                 { FreeAligned(p); }
+void operator delete  (void* p, std::size_t, std::align_val_t) noexcept    { FreeAligned(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept    { FreeAligned(p); }
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Hotones::Bench {
+
+// ---------------------------------------------------------------------------
+// Bench.hpp — minimal timing harness for the ECS microbenchmarks.
+//
+//   Result r = Measure("view/2", n, [&] { reg.View<A, B>(...); });
+//
+// A case body processes n entities once. Measure runs it once untimed (to
+// warm caches and let pools reach their steady-state capacity), then
+// repeatedly until ~MIN_TIME has passed, and reports the median repetition
+// in ns per entity plus the heap allocations per entity averaged over every
+// timed repetition.
+// ---------------------------------------------------------------------------
+
+// Heap allocations made by the process so far (see Alloc.cpp).
+uint64_t AllocationCount() noexcept;
+
+struct Result {
+    std::string name;
+    size_t      entities        = 0;
+    size_t      reps            = 0;
+    double      nsPerEntity     = 0.0;
+    double      allocsPerEntity = 0.0;
+};
+
+// Stops the optimiser from discarding a value computed only for timing.
+template<typename T>
+inline void Consume(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline constexpr auto   MIN_TIME = std::chrono::milliseconds(200);
+inline constexpr size_t MIN_REPS = 3;
+inline constexpr size_t MAX_REPS = 1000;
+
+// Time body (which processes n entities per call). setup, if given, runs
+// untimed before every repetition.
+template<typename Setup, typename Body>
+Result Measure(std::string name, size_t n, Setup&& setup, Body&& body) {
+    using Clock = std::chrono::steady_clock;
+
+    setup();
+    body();
+
+    std::vector<double> samples;
+    uint64_t            allocs = 0;
+    const auto          until  = Clock::now() + MIN_TIME;
+    while (samples.size() < MIN_REPS || (samples.size() < MAX_REPS && Clock::now() < until)) {
+        setup();
+        const uint64_t a0 = AllocationCount();
+        const auto     t0 = Clock::now();
+        body();
+        const auto     t1 = Clock::now();
+        allocs += AllocationCount() - a0;
+        samples.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+    }
+
+    std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+    Result r;
+    r.name            = std::move(name);
+    r.entities        = n;
+    r.reps            = samples.size();
+    r.nsPerEntity     = samples[samples.size() / 2] / static_cast<double>(n);
+    r.allocsPerEntity = static_cast<double>(allocs) / static_cast<double>(samples.size() * n);
+    return r;
+}
+
+template<typename Body>
+Result Measure(std::string name, size_t n, Body&& body) {
+    return Measure(std::move(name), n, [] {}, std::forward<Body>(body));
+}
+
+} // namespace Hotones::Bench
@@ -0,0 +1,5 @@
+// The engine's ecs.* Lua library, built into the benchmark as-is so the Lua
+// cases measure the shipping bindings rather than a copy. (It only needs
+// raylib for TraceLog and the header-only ECS, so the rest of the engine
+// does not have to be linked.)
+#include "../../src/Scripting/LuaLibraries/ECS.cpp"
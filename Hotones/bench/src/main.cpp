@@ -0,0 +1,373 @@
+#include "Bench.hpp"
+
+#include <lua.hpp>
+#include <ECS/ECS.hpp>
+#include <Scripting/LuaLoader/ECS.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// ECS microbenchmarks.
+//
+//   habenero-bench [--out results.json] [--baseline old.json] [--max N]
+//
+// Runs every case at 1k, 10k, 100k and 1M entities (capped by --max), prints
+// ns/entity and allocations/entity, and writes the results as JSON (one
+// result per line, so two runs diff cleanly). With --baseline, each result
+// is also printed as a percentage change against the matching result of an
+// earlier run.
+// ---------------------------------------------------------------------------
+
+using namespace Hotones;
+using namespace Hotones::ECS;
+using Bench::Measure;
+using Bench::Result;
+
+namespace {
+
+constexpr size_t SIZES[] = { 1'000, 10'000, 100'000, 1'000'000 };
+
+// Five components for the View cases: two chunked, three vector-backed.
+float Touch(const TransformComponent& t) { return t.position.x; }
+float Touch(const VelocityComponent& v)  { return v.linear.x; }
+float Touch(const HealthComponent& h)    { return h.current; }
+float Touch(const LifetimeComponent& l)  { return l.remaining; }
+float Touch(const GroupComponent& g)     { return static_cast<float>(g.groupId); }
+
+// n entities owning all five View components.
+std::vector<EntityId> Populate(Registry& reg, size_t n) {
+    std::vector<EntityId> ids = reg.CreateEntities(n);
+    for (size_t i = 0; i < n; ++i) {
+        const float f = static_cast<float>(i);
+        reg.AddComponent<TransformComponent>(ids[i], TransformComponent{ { f, 0.0f, 0.0f } });
+        reg.AddComponent<VelocityComponent>(ids[i], VelocityComponent{ { 1.0f, 0.0f, 0.0f } });
+        reg.AddComponent<HealthComponent>(ids[i], HealthComponent{ 100.0f, 100.0f });
+        reg.AddComponent<LifetimeComponent>(ids[i], LifetimeComponent{ 10.0f });
+        reg.AddComponent<GroupComponent>(ids[i], GroupComponent{ static_cast<uint32_t>(i & 7) });
+    }
+    return ids;
+}
+
+// -- Registry lifecycle ------------------------------------------------------
+
+void EntityCases(size_t n, std::vector<Result>& out) {
+    Registry              reg;
+    std::vector<EntityId> ids(n);
+
+    out.push_back(Measure("entity/create+destroy", n, [&] {
+        for (size_t i = 0; i < n; ++i) ids[i] = reg.CreateEntity();
+        for (size_t i = 0; i < n; ++i) reg.DestroyEntity(ids[i]);
+    }));
+
+    out.push_back(Measure("entity/create+destroy-bulk", n, [&] {
+        reg.CreateEntities(std::span<EntityId>(ids));
+        reg.DestroyEntities(ids);
+    }));
+}
+
+template<typename T>
+void AddRemoveCase(const char* name, size_t n, std::vector<Result>& out) {
+    Registry                    reg;
+    const std::vector<EntityId> ids = reg.CreateEntities(n);
+
+    out.push_back(Measure(name, n, [&] {
+        for (const EntityId id : ids) reg.AddComponent<T>(id, T{});
+        for (const EntityId id : ids) reg.RemoveComponent<T>(id);
+    }));
+}
+
+void ComponentCases(size_t n, std::vector<Result>& out) {
+    AddRemoveCase<TransformComponent>("component/add+remove/Transform", n, out);
+    AddRemoveCase<HealthComponent>("component/add+remove/Health", n, out);
+
+    // The pool on its own, without the Registry's mask / group bookkeeping.
+    ComponentPool<HealthComponent> pool;
+    out.push_back(Measure("pool/emplace+remove/Health", n, [&] {
+        for (uint32_t i = 0; i < n; ++i) pool.Emplace(i, HealthComponent{});
+        for (uint32_t i = 0; i < n; ++i) pool.Remove(i);
+    }));
+
+    for (uint32_t i = 0; i < n; ++i) pool.Emplace(i, HealthComponent{});
+    out.push_back(Measure("pool/get/Health", n, [&] {
+        float sum = 0.0f;
+        for (uint32_t i = 0; i < n; ++i) sum += std::as_const(pool).Get(i).current;
+        Bench::Consume(sum);
+    }));
+}
+
+// -- Queries -----------------------------------------------------------------
+
+template<typename... Ts>
+Result ViewCase(Registry& reg, size_t n) {
+    return Measure("view/" + std::to_string(sizeof...(Ts)), n, [&] {
+        float sum = 0.0f;
+        reg.View<Ts...>([&](EntityId, Ts&... c) { sum += (Touch(c) + ...); });
+        Bench::Consume(sum);
+    });
+}
+
+void QueryCases(size_t n, std::vector<Result>& out) {
+    Registry reg;
+    Populate(reg, n);
+
+    out.push_back(ViewCase<TransformComponent>(reg, n));
+    out.push_back(ViewCase<TransformComponent, VelocityComponent>(reg, n));
+    out.push_back(ViewCase<TransformComponent, VelocityComponent, HealthComponent>(reg, n));
+    out.push_back(ViewCase<TransformComponent, VelocityComponent, HealthComponent,
+                           LifetimeComponent>(reg, n));
+    out.push_back(ViewCase<TransformComponent, VelocityComponent, HealthComponent,
+                           LifetimeComponent, GroupComponent>(reg, n));
+
+    out.push_back(Measure("each/Transform", n, [&] {
+        reg.Each<TransformComponent>([](EntityId, TransformComponent& t) { t.position.x += 1.0f; });
+    }));
+    out.push_back(Measure("each/const Transform", n, [&] {
+        float sum = 0.0f;
+        reg.Each<const TransformComponent>([&](EntityId, const TransformComponent& t) { sum += t.position.x; });
+        Bench::Consume(sum);
+    }));
+}
+
+// -- Snapshots ---------------------------------------------------------------
+
+// A restored hierarchy must keep working: after Deserialize, a fresh
+// TransformHierarchySystem (as on a --snapshot warm start) has to compose
+// the child's world transform from its restored parent, including after
+// the parent moves.
+bool SnapshotHierarchyRoundTrips() {
+    Registry       reg;
+    const EntityId root  = reg.CreateEntity();
+    const EntityId child = reg.CreateEntity();
+    reg.AddComponent<TransformComponent>(root,  TransformComponent{ { 1.0f, 2.0f, 3.0f } });
+    reg.AddComponent<TransformComponent>(child, TransformComponent{ { 0.0f, 5.0f, 0.0f } });
+    if (!SetParent(reg, child, root)) return false;
+    TransformHierarchySystem{}.Update(reg, 0.0f);
+
+    const SnapshotSchema schema = SnapshotSchema::Builtin();
+    Registry             restored;
+    if (!restored.Deserialize(schema, reg.Serialize(schema))) return false;
+
+    TransformHierarchySystem system;
+    restored.AdvanceTick();
+    restored.GetComponent<TransformComponent>(root).position.x = 10.0f;
+    system.Update(restored, 0.0f);
+
+    const auto* world = std::as_const(restored).TryGetComponent<WorldTransformComponent>(child);
+    if (!world) return false;
+    const Vector3 p = world->Position();
+    return p.x == 10.0f && p.y == 7.0f && p.z == 3.0f;
+}
+
+void SnapshotCases(size_t n, std::vector<Result>& out) {
+    Registry reg;
+    Populate(reg, n);
+    const SnapshotSchema   schema = SnapshotSchema::Builtin();
+    std::vector<std::byte> bytes  = reg.Serialize(schema);
+
+    out.push_back(Measure("snapshot/save", n, [&] {
+        bytes = reg.Serialize(schema);
+        Bench::Consume(bytes.size());
+    }));
+
+    Registry restored;
+    out.push_back(Measure("snapshot/load", n, [&] {
+        Bench::Consume(restored.Deserialize(schema, bytes));
+    }));
+}
+
+// -- Lua ecs.* ---------------------------------------------------------------
+
+// Each chunk receives the array of entity ids and returns the function to time.
+constexpr const char* LUA_PER_ENTITY = R"(
+    local ids = ...
+    local getPos, setPos = ecs.getPos, ecs.setPos
+    return function()
+        for i = 1, #ids do
+            local id = ids[i]
+            local x, y, z = getPos(id)
+            setPos(id, x + 1, y, z)
+        end
+    end)";
+
+constexpr const char* LUA_QUERY_UPDATE = R"(
+    return function()
+        local b = ecs.query({ "Transform" })
+        local x = b.x
+        for i = 1, b.n do x[i] = x[i] + 1 end
+        ecs.update({ "Transform" }, b)
+    end)";
+
+constexpr const char* LUA_QUERY_BATCHED = R"(
+    return function()
+        ecs.query({ "Transform" }, function(b)
+            local x = b.x
+            for i = 1, b.n do x[i] = x[i] + 1 end
+        end)
+    end)";
+
+constexpr const char* LUA_EACH = R"(
+    return function()
+        ecs.each({ "Transform" }, function(id, x, y, z) return x + 1 end)
+    end)";
+
+// Compile chunk with the ids table as its argument and leave the returned
+// function in the registry; returns its reference.
+int LoadLuaCase(lua_State* L, const char* chunk, int idsRef) {
+    if (luaL_loadstring(L, chunk) != LUA_OK) {
+        std::cerr << "[bench] " << lua_tostring(L, -1) << "\n";
+        std::exit(1);
+    }
+    lua_rawgeti(L, LUA_REGISTRYINDEX, idsRef);
+    if (lua_pcall(L, 1, 1, 0) != LUA_OK) {
+        std::cerr << "[bench] " << lua_tostring(L, -1) << "\n";
+        std::exit(1);
+    }
+    return luaL_ref(L, LUA_REGISTRYINDEX);
+}
+
+void LuaCases(size_t n, std::vector<Result>& out) {
+    Registry                    reg;
+    const std::vector<EntityId> ids = Populate(reg, n);
+
+    lua_State* L = luaL_newstate();
+    luaL_openlibs(L);
+    Scripting::LuaLoader::registerECS(L);
+    Scripting::LuaLoader::setECSRegistry(&reg);
+
+    lua_createtable(L, static_cast<int>(n), 0);
+    for (size_t i = 0; i < n; ++i) {
+        lua_pushinteger(L, static_cast<lua_Integer>(ids[i]));
+        lua_rawseti(L, -2, static_cast<lua_Integer>(i + 1));
+    }
+    const int idsRef = luaL_ref(L, LUA_REGISTRYINDEX);
+
+    const std::pair<const char*, const char*> cases[] = {
+        { "lua/getPos+setPos",     LUA_PER_ENTITY    },
+        { "lua/query+update",      LUA_QUERY_UPDATE  },
+        { "lua/query-batched",     LUA_QUERY_BATCHED },
+        { "lua/each",              LUA_EACH          },
+    };
+    for (const auto& [name, chunk] : cases) {
+        const int fn = LoadLuaCase(L, chunk, idsRef);
+        // Collect between repetitions so one case's garbage is not billed
+        // to the next.
+        out.push_back(Measure(name, n, [&] { lua_gc(L, LUA_GCCOLLECT, 0); }, [&] {
+            lua_rawgeti(L, LUA_REGISTRYINDEX, fn);
+            if (lua_pcall(L, 0, 0, 0) != LUA_OK) {
+                std::cerr << "[bench] " << name << ": " << lua_tostring(L, -1) << "\n";
+                std::exit(1);
+            }
+        }));
+        luaL_unref(L, LUA_REGISTRYINDEX, fn);
+    }
+
+    Scripting::LuaLoader::setECSRegistry(nullptr);
+    lua_close(L);
+}
+
+// -- Output ------------------------------------------------------------------
+
+std::string Key(const std::string& name, size_t entities) {
+    return name + "@" + std::to_string(entities);
+}
+
+// ns/entity by Key() from a file written by WriteJson.
+std::map<std::string, double> ReadBaseline(const std::string& path) {
+    std::map<std::string, double> base;
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "[bench] Cannot read baseline " << path << "\n";
+        return base;
+    }
+    for (std::string line; std::getline(in, line);) {
+        char   name[128];
+        size_t entities = 0;
+        double ns       = 0.0;
+        const char* p = std::strstr(line.c_str(), "{\"name\"");
+        if (p && std::sscanf(p, "{\"name\": \"%127[^\"]\", \"entities\": %zu, \"reps\": %*u, \"ns_per_entity\": %lf",
+                             name, &entities, &ns) == 3)
+            base[Key(name, entities)] = ns;
+    }
+    return base;
+}
+
+void WriteJson(const std::string& path, const std::vector<Result>& results) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        std::cerr << "[bench] Cannot write " << path << "\n";
+        return;
+    }
+    out << "{\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        char line[256];
+        std::snprintf(line, sizeof line,
+                      "    {\"name\": \"%s\", \"entities\": %zu, \"reps\": %zu, "
+                      "\"ns_per_entity\": %.3f, \"allocs_per_entity\": %.4f}%s\n",
+                      r.name.c_str(), r.entities, r.reps, r.nsPerEntity, r.allocsPerEntity,
+                      i + 1 < results.size() ? "," : "");
+        out << line;
+    }
+    out << "  ]\n}\n";
+}
+
+void Print(const Result& r, const std::map<std::string, double>& baseline) {
+    std::printf("  %-34s %9.2f ns/entity  %8.4f allocs/entity", r.name.c_str(), r.nsPerEntity, r.allocsPerEntity);
+    if (const auto it = baseline.find(Key(r.name, r.entities)); it != baseline.end() && it->second > 0.0)
+        std::printf("  %+7.1f%%", (r.nsPerEntity / it->second - 1.0) * 100.0);
+    std::printf("\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string outPath = "ecs_bench.json";
+    std::string baselinePath;
+    size_t      maxEntities = SIZES[std::size(SIZES) - 1];
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--out" && i + 1 < argc)           outPath      = argv[++i];
+        else if (arg == "--baseline" && i + 1 < argc) baselinePath = argv[++i];
+        else if (arg == "--max" && i + 1 < argc)      maxEntities  = std::strtoull(argv[++i], nullptr, 10);
+        else {
+            std::cerr << "usage: " << argv[0] << " [--out results.json] [--baseline old.json] [--max N]\n";
+            return 1;
+        }
+    }
+
+    const std::map<std::string, double> baseline =
+        baselinePath.empty() ? std::map<std::string, double>{} : ReadBaseline(baselinePath);
+
+    if (!SnapshotHierarchyRoundTrips()) {
+        std::cerr << "[bench] Snapshot round trip lost the transform hierarchy\n";
+        return 1;
+    }
+
+    std::vector<Result> results;
+    for (const size_t n : SIZES) {
+        if (n > maxEntities) break;
+        std::printf("%zu entities\n", n);
+        const size_t first = results.size();
+        EntityCases(n, results);
+        ComponentCases(n, results);
+        QueryCases(n, results);
+        SnapshotCases(n, results);
+        LuaCases(n, results);
+        for (size_t i = first; i < results.size(); ++i) Print(results[i], baseline);
+    }
+
+    WriteJson(outPath, results);
+    std::printf("Wrote %s\n", outPath.c_str());
+    return 0;
+}
@@ -112,6 +112,10 @@ bool CollidableModel::CheckCollision(Vector3 point) const {
            (point.z >= bbox.min.z && point.z <= bbox.max.z);
 }
 
+bool CollidableModel::IsCollisionReady() const {
+    return physicsHandle == -1 || Hotones::Physics::IsMeshReady(physicsHandle);
+}
+
 bool CollidableModel::ResolveSphereCollision(Vector3 &center, float radius) {
     if (physicsHandle == -1) return false;
     return Hotones::Physics::ResolveSphereAgainstStatic(physicsHandle, center, radius);
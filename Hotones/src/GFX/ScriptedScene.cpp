@@ -8,6 +8,7 @@
 #include <server/NetworkManager.hpp>
 #include <raylib.h>
 #include <raymath.h>
+#include <utility>
 
 namespace Hotones {
 
@@ -70,26 +71,50 @@ void ScriptedScene::Update()
     // ── ECS tick ──────────────────────────────────────────────────────────────
     const float dt = GetFrameTime();
 
+    // New change-tracking tick: Changed<T> queries below see this frame only.
+    m_registry.AdvanceTick();
+
     // Keep TransformComponent in sync with the engine player's live position
     // so Lua can read ecs.getPos(playerEntityId) and get an up-to-date value.
-    m_registry.Each<ECS::PlayerComponent>(
-        [&](ECS::EntityId id, ECS::PlayerComponent& pc) {
+    // Only write (and mark changed) when the player actually moved.
+    m_registry.Each<const ECS::PlayerComponent>(
+        [&](ECS::EntityId id, const ECS::PlayerComponent& pc) {
             if (!pc.player) return;
-            if (m_registry.HasComponent<ECS::TransformComponent>(id))
-                m_registry.GetComponent<ECS::TransformComponent>(id).position =
-                    pc.player->body.position;
+            const auto* t = std::as_const(m_registry).TryGetComponent<ECS::TransformComponent>(id);
+            if (!t) return;
+            const Vector3 p = pc.player->body.position;
+            if (t->position.x == p.x && t->position.y == p.y && t->position.z == p.z) return;
+            m_registry.GetComponent<ECS::TransformComponent>(id).position = p;
         });
 
-    // Tick lifetime components and collect expired entities.
-    std::vector<ECS::EntityId> toDestroy;
-    m_registry.Each<ECS::LifetimeComponent>(
-        [&](ECS::EntityId id, ECS::LifetimeComponent& lt) {
-            lt.remaining -= dt;
-            if (lt.remaining <= 0.0f) toDestroy.push_back(id);
-        });
-    for (auto id : toDestroy) m_registry.DestroyEntity(id);
+    // Sync point: deliver the component construct / destroy events buffered
+    // since the last one.
+    m_registry.DispatchEvents();
+
+    // Count lifetimes down and destroy expired entities in one batch.
+    m_lifetimes.Update(m_registry, dt);
+
+    // Move projectiles / particles stored as KinematicComponent (SoA streams)
+    // and destroy the ones whose lifetime ran out.
+    m_kinematics.Update(m_registry, dt);
+
+    // Hand the expired entities and the deaths found at the end of the last
+    // frame to the pack as one list each, before its Update.
+    if (m_script) {
+        m_expired.assign(m_lifetimes.Expired().begin(), m_lifetimes.Expired().end());
+        m_expired.insert(m_expired.end(), m_kinematics.Expired().begin(), m_kinematics.Expired().end());
+        m_script->fireEntitiesExpired(m_expired);
+        m_script->fireEntitiesDied(m_deaths.Died());
+        m_script->update();
+    }
+
+    // Collect entities whose health reached zero this frame — after the
+    // pack's Update, so damage dealt there is seen.
+    m_deaths.Update(m_registry, dt);
 
-    if (m_script) m_script->update();
+    // Compose world transforms for parented entities, after every Transform
+    // write of the frame.
+    m_hierarchy.Update(m_registry, dt);
 }
 
 void ScriptedScene::Draw()
@@ -2,28 +2,90 @@
 #include <server/NetworkManager.hpp>
 #include <Scripting/CupLoader.hpp>
 #include <Scripting/CupPackage.hpp>
+#include <Scripting/LuaLoader/ECS.hpp>
+#include <ECS/ECS.hpp>
 
 #include <atomic>
 #include <chrono>
 #include <csignal>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <thread>
+#include <vector>
 
 namespace {
     std::atomic<bool> g_serverRunning{ true };
+
+    // Seconds between world checkpoints when a snapshot path is set.
+    constexpr auto CHECKPOINT_INTERVAL = std::chrono::seconds(30);
 }
 
 static void SignalHandler(int /*sig*/) {
     g_serverRunning = false;
 }
 
+// Restore world from the snapshot at path. Returns false if there is no
+// usable snapshot (world is then left empty for the pack to build).
+static bool LoadWorldSnapshot(Hotones::ECS::Registry& world,
+                              const Hotones::ECS::SnapshotSchema& schema,
+                              const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    const std::vector<char> raw((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const bool ok = world.Deserialize(schema,
+        std::span(reinterpret_cast<const std::byte*>(raw.data()), raw.size()));
+    const auto t1 = std::chrono::steady_clock::now();
+    if (!ok) {
+        std::cerr << "[Server] Snapshot " << path << " is invalid, ignoring it.\n";
+        return false;
+    }
+    std::cout << "[Server] Restored " << world.EntityCount() << " entities from " << path << " in "
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms\n";
+    return true;
+}
+
+// Write a checkpoint of world to path (via a temp file, so a crash while
+// writing never leaves a torn snapshot behind).
+static void SaveWorldSnapshot(const Hotones::ECS::Registry& world,
+                              const Hotones::ECS::SnapshotSchema& schema,
+                              const std::string& path) {
+    const std::vector<std::byte> bytes = world.Serialize(schema);
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<const char*>(bytes.data()),
+                        static_cast<std::streamsize>(bytes.size()))) {
+            std::cerr << "[Server] Failed to write snapshot " << tmp << "\n";
+            return;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) std::cerr << "[Server] Failed to replace snapshot " << path << ": " << ec.message() << "\n";
+}
+
 namespace Hotones {
 
-void RunHeadlessServer(uint16_t port, const std::string& pakPath) {
+void RunHeadlessServer(uint16_t port, const std::string& pakPath, const std::string& snapshotPath) {
     std::signal(SIGINT,  SignalHandler);
     std::signal(SIGTERM, SignalHandler);
 
+    // -- ECS world ------------------------------------------------------------
+    // Shared with the pack's ecs.* Lua API; restored from / checkpointed to
+    // snapshotPath when one is given.
+    ECS::Registry             world;
+    const ECS::SnapshotSchema schema = ECS::SnapshotSchema::Builtin();
+    Scripting::LuaLoader::setECSRegistry(&world);
+
+    // Warm start: restore the last checkpoint before the pack initialises, so
+    // its Init sees ecs.isRestored() and skips building the world.
+    if (!snapshotPath.empty())
+        Scripting::LuaLoader::setECSRestored(LoadWorldSnapshot(world, schema, snapshotPath));
+
     // -- Optional game pack ---------------------------------------------------
     Hotones::Scripting::CupPackage pak;
     Hotones::Scripting::CupLoader  script;
@@ -85,14 +147,38 @@ void RunHeadlessServer(uint16_t port, const std::string& pakPath) {
     std::cout << "[Server] Press Ctrl+C to shut down.\n";
 
     // -- Main loop ------------------------------------------------------------
+    ECS::LifetimeSystem lifetimes;
+    ECS::DeathSystem    deaths;
+    auto nextCheckpoint = std::chrono::steady_clock::now() + CHECKPOINT_INTERVAL;
+    auto lastTick       = std::chrono::steady_clock::now();
     while (g_serverRunning.load()) {
+        const auto  now = std::chrono::steady_clock::now();
+        const float dt  = std::chrono::duration<float>(now - lastTick).count();
+        lastTick = now;
+
+        world.AdvanceTick();
         server.Update();
-        if (hasPak) script.update();
+
+        lifetimes.Update(world, dt);
+        if (hasPak) {
+            script.fireEntitiesExpired(lifetimes.Expired());
+            script.fireEntitiesDied(deaths.Died());
+            script.update();
+        }
+        deaths.Update(world, dt);   // after the pack's Update; reported next tick
+        world.DispatchEvents();     // component observers, once per tick
+
+        if (!snapshotPath.empty() && std::chrono::steady_clock::now() >= nextCheckpoint) {
+            SaveWorldSnapshot(world, schema, snapshotPath);
+            nextCheckpoint = std::chrono::steady_clock::now() + CHECKPOINT_INTERVAL;
+        }
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
 
     std::cout << "\n[Server] Shutting down...\n";
+    if (!snapshotPath.empty()) SaveWorldSnapshot(world, schema, snapshotPath);
     server.StopServer();
+    Scripting::LuaLoader::setECSRegistry(nullptr);
     std::cout << "[Server] Goodbye!\n";
 }
 
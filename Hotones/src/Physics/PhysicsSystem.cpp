@@ -1,9 +1,18 @@
 // Physics backend: triangle-accurate sphere sweeps via a mid-phase BVH.
 //
 // Design:
-//   BuildBVH()              — recursive median-split BVH over triangles
-//   SweepSphereNode()       — traverse BVH, run analytic sphere-vs-tri test per leaf
-//   PenetrationSphereNode() — traverse BVH, resolve sphere-vs-tri overlap
+//   BVH::Build()            — binned-SAH BVH over triangles (centroid-mean
+//                             split for very large meshes); runs as a job on
+//                             the build pool, big subtrees in parallel
+//   BVH::Collapse()         — flatten the binary tree into 4-wide nodes (SoA
+//                             child boxes, tested 4 at a time with SSE)
+//   SweepNodeBVH()          — traverse BVH4, run analytic sphere-vs-tri test per leaf
+//   PenetrationNodeBVH()    — traverse BVH4, resolve sphere-vs-tri overlap
+//   RaycastNodeBVH()        — traverse BVH4 front-to-back, Möller-Trumbore per leaf
+//   TraversePacket()        — traverse BVH4 with four coherent queries at once
+//                             (RaycastBatch / SweepSphereBatch)
+//   AcquireMesh()           — lock-free handle → mesh lookup for queries
+//                             (generation-checked slot table, ref-counted meshes)
 //
 // Sphere-vs-triangle sweep:
 //   We cast a ray from (start) to (end) against the "inflated" geometry of each
@@ -15,20 +24,26 @@
 //   We return the earliest parametric hit t ∈ [0,1].
 
 #include "../include/Physics/PhysicsSystem.hpp"
+#include <Jobs/JobPool.hpp>
 #include <algorithm>
 #include <cfloat>
 #include <cstring>
 #include <iostream>
 #include <raylib.h>
 #include <memory>
-#include <thread>
 #include <condition_variable>
 #include <atomic>
-#include <deque>
 #include <mutex>
+#include <thread>
+#include <utility>
 #include <vector>
 #include <raymath.h>
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define HOTONES_PHYSICS_SSE 1
+#include <xmmintrin.h>
+#endif
+
 // ─── Geometry helpers (file-internal) ────────────────────────────────────────
 
 static inline float v3dot(Vector3 a, Vector3 b) { return Vector3DotProduct(a, b); }
@@ -220,20 +235,62 @@ struct BVHNode {
     int rightChild = -1; // -1 → leaf
 };
 
+// 4-wide node of the query-time tree. Child boxes are stored per axis so
+// one SSE op tests the same axis of all four. child[i] >= 0 is an inner
+// node index; child[i] < 0 is leaf ~child[i] in BVH::leaves. Slots
+// [count, 4) are unused.
+struct alignas(16) BVH4Node {
+    float   bminX[4], bminY[4], bminZ[4];
+    float   bmaxX[4], bmaxY[4], bmaxZ[4];
+    int32_t child[4];
+    int32_t count = 0;
+};
+
+struct BVH4Leaf {
+    int triStart = 0, triCount = 0;
+};
+
+// Triangle counts above which Build() uses the cheap centroid-mean split
+// instead of the binned SAH (keeps load times bounded for huge meshes).
+static constexpr size_t BVH_SAH_MAX_TRIS = 1'000'000;
+// SAH bins per axis.
+static constexpr int    BVH_SAH_BINS     = 16;
+// Leaves are always made at this many triangles or fewer; the SAH may also
+// stop splitting at up to BVH_SAH_MAX_LEAF when a split does not pay off.
+static constexpr int    BVH_MIN_LEAF     = 4;
+static constexpr int    BVH_SAH_MAX_LEAF = 8;
+// Subtrees over at least this many triangles build their two children
+// concurrently when Build() is given a JobPool.
+static constexpr int    BVH_PARALLEL_MIN_TRIS = 16384;
+// SAH cost of visiting a node, relative to one triangle test.
+static constexpr float  BVH_TRAVERSAL_COST = 1.0f;
+
 struct BVH {
-    std::vector<BVHNode> nodes;
+    std::vector<BVHNode> nodes;  // binary tree; only kept while building
     std::vector<Tri>     tris;   // reordered
-
-    // Build from a flat triangle list
-    void Build(std::vector<Tri>&& inTris) {
+    // Query-time tree: 4-wide nodes (root at 0), their leaves, and the
+    // depth of the deepest node (sizes the traversal stack).
+    std::vector<BVH4Node> wide;
+    std::vector<BVH4Leaf> leaves;
+    int                   wideDepth = 0;
+
+    // Build from a flat triangle list. With a pool, the top of the tree is
+    // split into subtrees that are built concurrently on it.
+    void Build(std::vector<Tri>&& inTris, Hotones::Jobs::JobPool* pool = nullptr) {
         tris = std::move(inTris);
-        if (tris.empty()) return;
         nodes.clear();
-        nodes.reserve(tris.size() * 2);
-        BuildNode(0, (int)tris.size(), 0);
+        wide.clear();
+        leaves.clear();
+        if (tris.empty()) return;
+        useSah = tris.size() <= BVH_SAH_MAX_TRIS;
+        nodes = BuildSubtree(0, (int)tris.size(), pool);
+        Collapse();
+        nodes = {};
     }
 
 private:
+    bool useSah = true;
+
     static Vector3 TriAabbMin(const Tri& t) {
         return { fminf(t.a.x, fminf(t.b.x, t.c.x)),
                  fminf(t.a.y, fminf(t.b.y, t.c.y)),
@@ -244,111 +301,435 @@ private:
                  fmaxf(t.a.y, fmaxf(t.b.y, t.c.y)),
                  fmaxf(t.a.z, fmaxf(t.b.z, t.c.z)) };
     }
+    static void Grow(Vector3& bmin, Vector3& bmax, Vector3 mn, Vector3 mx) {
+        bmin = { fminf(bmin.x, mn.x), fminf(bmin.y, mn.y), fminf(bmin.z, mn.z) };
+        bmax = { fmaxf(bmax.x, mx.x), fmaxf(bmax.y, mx.y), fmaxf(bmax.z, mx.z) };
+    }
+    // Half the surface area of a box (the SAH only compares ratios).
+    static float HalfArea(Vector3 bmin, Vector3 bmax) {
+        Vector3 e = v3sub(bmax, bmin);
+        return e.x*e.y + e.y*e.z + e.z*e.x;
+    }
 
-    int BuildNode(int start, int end, int /*depth*/) {
-        int nodeIdx = (int)nodes.size();
-        nodes.push_back({});
-        BVHNode& node = nodes[nodeIdx];
+    static int BinOf(const Tri& t, int axis, float cmin, float scale) {
+        const int b = (int)(((&t.centroid.x)[axis] - cmin) * scale);
+        return std::clamp(b, 0, BVH_SAH_BINS - 1);
+    }
 
-        // Compute AABB
-        node.bmin = TriAabbMin(tris[start]);
-        node.bmax = TriAabbMax(tris[start]);
-        for (int i = start+1; i < end; ++i) {
-            Vector3 mn = TriAabbMin(tris[i]);
-            Vector3 mx = TriAabbMax(tris[i]);
-            node.bmin = { fminf(node.bmin.x, mn.x), fminf(node.bmin.y, mn.y), fminf(node.bmin.z, mn.z) };
-            node.bmax = { fmaxf(node.bmax.x, mx.x), fmaxf(node.bmax.y, mx.y), fmaxf(node.bmax.z, mx.z) };
+    struct Split {
+        int   axis = -1;
+        int   bin  = 0;     // left side = bins [0, bin]
+        float cost = FLT_MAX;
+        float cmin = 0.f, scale = 0.f;
+    };
+
+    // Binned SAH: bucket centroids into BVH_SAH_BINS slabs per axis and pick
+    // the slab boundary minimising  area(L)*count(L) + area(R)*count(R).
+    // The returned cost is relative to the parent's area.
+    Split FindSahSplit(int start, int end, Vector3 bmin, Vector3 bmax) const {
+        Vector3 cmin = tris[start].centroid, cmax = cmin;
+        for (int i = start+1; i < end; ++i) Grow(cmin, cmax, tris[i].centroid, tris[i].centroid);
+
+        struct Bin { Vector3 bmin, bmax; int count = 0; };
+        Bin   bins[3][BVH_SAH_BINS];
+        float scale[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            const float extent = (&cmax.x)[axis] - (&cmin.x)[axis];
+            // Flat axes (all centroids in one plane) are not split on.
+            scale[axis] = extent < 1e-6f ? 0.f : (float)BVH_SAH_BINS * (1.f - 1e-5f) / extent;
+            for (Bin& b : bins[axis]) { b.bmin = { FLT_MAX, FLT_MAX, FLT_MAX }; b.bmax = { -FLT_MAX, -FLT_MAX, -FLT_MAX }; }
+        }
+        for (int i = start; i < end; ++i) {
+            const Tri& t = tris[i];
+            const Vector3 mn = TriAabbMin(t), mx = TriAabbMax(t);
+            for (int axis = 0; axis < 3; ++axis) {
+                if (scale[axis] == 0.f) continue;
+                Bin& b = bins[axis][BinOf(t, axis, (&cmin.x)[axis], scale[axis])];
+                b.count++;
+                Grow(b.bmin, b.bmax, mn, mx);
+            }
         }
 
-        int count = end - start;
-        if (count <= 4) {
-            // Leaf
-            node.triStart = start;
-            node.triCount = count;
-            node.rightChild = -1;
-            return nodeIdx;
+        Split best;
+        for (int axis = 0; axis < 3; ++axis) {
+            if (scale[axis] == 0.f) continue;
+            const Bin* b = bins[axis];
+
+            // Right-to-left sweep: cost contribution of bins (i, BINS).
+            float rightCost[BVH_SAH_BINS];
+            Vector3 mn = { FLT_MAX, FLT_MAX, FLT_MAX }, mx = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+            int n = 0;
+            for (int i = BVH_SAH_BINS - 1; i > 0; --i) {
+                if (b[i].count) { Grow(mn, mx, b[i].bmin, b[i].bmax); n += b[i].count; }
+                rightCost[i - 1] = n ? HalfArea(mn, mx) * (float)n : 0.f;
+            }
+            // Left-to-right sweep, combining with the right side.
+            mn = { FLT_MAX, FLT_MAX, FLT_MAX }; mx = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+            n = 0;
+            for (int i = 0; i < BVH_SAH_BINS - 1; ++i) {
+                if (b[i].count) { Grow(mn, mx, b[i].bmin, b[i].bmax); n += b[i].count; }
+                if (n == 0 || n == end - start) continue;
+                const float cost = HalfArea(mn, mx) * (float)n + rightCost[i];
+                if (cost < best.cost) best = { axis, i, cost, (&cmin.x)[axis], scale[axis] };
+            }
         }
 
-        // Split on longest axis at centroid median
-        Vector3 ext = v3sub(node.bmax, node.bmin);
+        const float parentArea = HalfArea(bmin, bmax);
+        if (best.axis >= 0)
+            best.cost = BVH_TRAVERSAL_COST + (parentArea > 0.f ? best.cost / parentArea : 0.f);
+        return best;
+    }
+
+    // Centroid-mean split on the longest axis. Returns the split index.
+    int MeanSplit(int start, int end, Vector3 bmin, Vector3 bmax) {
+        Vector3 ext = v3sub(bmax, bmin);
         int axis = (ext.x > ext.y && ext.x > ext.z) ? 0 : (ext.y > ext.z ? 1 : 2);
         float mid = 0.f;
         for (int i = start; i < end; ++i) {
             float* c = &tris[i].centroid.x;
             mid += c[axis];
         }
-        mid /= (float)count;
+        mid /= (float)(end - start);
 
         auto midIt = std::partition(tris.begin() + start, tris.begin() + end,
                                     [axis, mid](const Tri& t){
                                         const float* c = &t.centroid.x;
                                         return c[axis] < mid;
                                     });
-        int split = (int)(midIt - tris.begin());
+        return (int)(midIt - tris.begin());
+    }
+
+    // Bounds of tris [start, end).
+    void Bounds(int start, int end, Vector3& bmin, Vector3& bmax) const {
+        bmin = TriAabbMin(tris[start]);
+        bmax = TriAabbMax(tris[start]);
+        for (int i = start+1; i < end; ++i)
+            Grow(bmin, bmax, TriAabbMin(tris[i]), TriAabbMax(tris[i]));
+    }
+
+    // Partition tris [start, end) for a node with the given bounds and
+    // return the split index, or -1 if the node should be a leaf.
+    int ChooseSplit(int start, int end, Vector3 bmin, Vector3 bmax) {
+        int count = end - start;
+        if (count <= BVH_MIN_LEAF) return -1;
+
+        int split = -1;
+        if (useSah) {
+            const Split s = FindSahSplit(start, end, bmin, bmax);
+            if (s.axis >= 0) {
+                // Splitting costs more than testing every triangle: stay a leaf.
+                if (count <= BVH_SAH_MAX_LEAF && s.cost >= (float)count) return -1;
+                auto midIt = std::partition(tris.begin() + start, tris.begin() + end,
+                                            [&s](const Tri& t){
+                                                return BinOf(t, s.axis, s.cmin, s.scale) <= s.bin;
+                                            });
+                split = (int)(midIt - tris.begin());
+            }
+        }
+        if (split < 0) split = MeanSplit(start, end, bmin, bmax);
         if (split == start || split == end) split = start + count / 2;
+        return split;
+    }
+
+    // Append the subtree over tris [start, end) to out (depth-first, left
+    // child directly after its parent). Returns the subtree root's index.
+    int BuildNode(std::vector<BVHNode>& out, int start, int end) {
+        int nodeIdx = (int)out.size();
+        out.push_back({});
+        Vector3 bmin, bmax;
+        Bounds(start, end, bmin, bmax);
+        out[nodeIdx].bmin = bmin;
+        out[nodeIdx].bmax = bmax;
+
+        const int split = ChooseSplit(start, end, bmin, bmax);
+        if (split < 0) {
+            // Leaf
+            out[nodeIdx].triStart = start;
+            out[nodeIdx].triCount = end - start;
+            out[nodeIdx].rightChild = -1;
+            return nodeIdx;
+        }
 
-        node.triStart = -1; node.triCount = 0;
-        BuildNode(start, split, 0);                    // left child (always nodeIdx+1)
-        node.rightChild = BuildNode(split, end, 0);    // right child
-        // Re-fetch reference after possible vector reallocation
-        nodes[nodeIdx].rightChild = node.rightChild;
+        out[nodeIdx].triStart = -1; out[nodeIdx].triCount = 0;
+        BuildNode(out, start, split);                    // left child (always nodeIdx+1)
+        const int right = BuildNode(out, split, end);    // right child
+        out[nodeIdx].rightChild = right;
         return nodeIdx;
     }
+
+    // The subtree over tris [start, end) as its own node array (root at 0).
+    // Above BVH_PARALLEL_MIN_TRIS the two children are built concurrently
+    // — they touch disjoint triangle ranges — and spliced in after the root.
+    std::vector<BVHNode> BuildSubtree(int start, int end, Hotones::Jobs::JobPool* pool) {
+        std::vector<BVHNode> out;
+        if (!pool || end - start < BVH_PARALLEL_MIN_TRIS) {
+            out.reserve((size_t)(end - start) * 2 / BVH_MIN_LEAF + 1);
+            BuildNode(out, start, end);
+            return out;
+        }
+
+        BVHNode root;
+        Bounds(start, end, root.bmin, root.bmax);
+        const int split = ChooseSplit(start, end, root.bmin, root.bmax);
+        if (split < 0) {
+            root.triStart = start;
+            root.triCount = end - start;
+            out.push_back(root);
+            return out;
+        }
+
+        std::vector<BVHNode> left, right;
+        pool->ParallelFor(2, 1, [&](size_t child, size_t) {
+            if (child == 0) left  = BuildSubtree(start, split, pool);
+            else            right = BuildSubtree(split, end, pool);
+        });
+
+        root.triStart   = -1;
+        root.rightChild = 1 + (int)left.size();
+        out.reserve(1 + left.size() + right.size());
+        out.push_back(root);
+        auto append = [&out](const std::vector<BVHNode>& sub, int offset) {
+            for (BVHNode n : sub) {
+                if (n.rightChild != -1) n.rightChild += offset;
+                out.push_back(n);
+            }
+        };
+        append(left, 1);
+        append(right, root.rightChild);
+        return out;
+    }
+
+    // Build wide / leaves from the binary nodes.
+    void Collapse() {
+        wide.reserve(nodes.size() / 3 + 1);
+        leaves.reserve(nodes.size() / 2 + 1);
+        wideDepth = 0;
+        if (nodes[0].rightChild == -1) {
+            // Single-leaf tree: a root with one leaf child.
+            wide.push_back({});
+            SetChild(0, 0, 0);
+            wide[0].count = 1;
+            wideDepth = 1;
+            return;
+        }
+        CollapseNode(0, 1);
+    }
+
+    // Emit the wide node for binary inner node b: its children are the up
+    // to four descendants reached by repeatedly opening the largest inner
+    // child. Returns the wide node's index.
+    int CollapseNode(int b, int depth) {
+        wideDepth = std::max(wideDepth, depth);
+        int kids[4] = { b + 1, nodes[b].rightChild, -1, -1 };
+        int count = 2;
+        while (count < 4) {
+            int open = -1;
+            float bestArea = -1.f;
+            for (int i = 0; i < count; ++i) {
+                const BVHNode& n = nodes[kids[i]];
+                if (n.rightChild == -1) continue;
+                const float area = HalfArea(n.bmin, n.bmax);
+                if (area > bestArea) { bestArea = area; open = i; }
+            }
+            if (open < 0) break;
+            const int opened = kids[open];
+            kids[open]     = opened + 1;
+            kids[count++]  = nodes[opened].rightChild;
+        }
+
+        const int w = (int)wide.size();
+        wide.push_back({});
+        wide[w].count = count;
+        for (int i = 0; i < count; ++i) SetChild(w, i, kids[i]);
+        for (int i = 0; i < count; ++i)
+            if (nodes[kids[i]].rightChild != -1) {
+                const int c = CollapseNode(kids[i], depth + 1);
+                wide[w].child[i] = c;   // re-index: wide may have reallocated
+            }
+        return w;
+    }
+
+    // Fill slot i of wide node w with binary node b's box (and, for a leaf,
+    // its triangle range).
+    void SetChild(int w, int i, int b) {
+        BVH4Node& n = wide[w];
+        const BVHNode& c = nodes[b];
+        n.bminX[i] = c.bmin.x; n.bminY[i] = c.bmin.y; n.bminZ[i] = c.bmin.z;
+        n.bmaxX[i] = c.bmax.x; n.bmaxY[i] = c.bmax.y; n.bmaxZ[i] = c.bmax.z;
+        if (c.rightChild == -1) {
+            n.child[i] = ~(int32_t)leaves.size();
+            leaves.push_back({ c.triStart, c.triCount });
+        } else {
+            n.child[i] = 0;   // set once the child is collapsed
+        }
+    }
+};
+
+// ─── BVH4 traversal helpers ──────────────────────────────────────────────────
+
+// Explicit traversal stack: each visited node pops one entry and pushes at
+// most four, so 3 * depth + 1 entries always suffice. Typical trees fit the
+// inline array; pathological deep ones spill to the heap.
+template<typename Entry>
+class NodeStack {
+public:
+    explicit NodeStack(const BVH& bvh) {
+        const size_t need = 3 * (size_t)bvh.wideDepth + 1;
+        if (need > INLINE) { m_heap.resize(need); m_data = m_heap.data(); }
+    }
+    void Push(Entry v)   { m_data[m_size++] = v; }
+    Entry Pop()          { return m_data[--m_size]; }
+    bool Empty() const   { return m_size == 0; }
+
+private:
+    static constexpr size_t INLINE = 192;
+    Entry                m_inline[INLINE];
+    std::vector<Entry>   m_heap;
+    Entry*               m_data = m_inline;
+    size_t               m_size = 0;
+};
+
+// Ray (or swept-sphere segment) prepared for slab tests: origin and
+// reciprocal direction, with near-zero components nudged so the slab
+// maths needs no special case.
+struct SlabRay {
+    Vector3 o, inv;
+
+    SlabRay(Vector3 origin, Vector3 dir) : o(origin) {
+        auto rcp = [](float d) { return 1.f / (fabsf(d) < 1e-10f ? (d < 0.f ? -1e-10f : 1e-10f) : d); };
+        inv = { rcp(dir.x), rcp(dir.y), rcp(dir.z) };
+    }
 };
 
-// AABB vs expanded AABB (expand box by radius) overlap check
-static bool AabbOverlap(Vector3 bmin, Vector3 bmax, Vector3 qmin, Vector3 qmax) {
-    return (bmin.x <= qmax.x && bmax.x >= qmin.x) &&
-           (bmin.y <= qmax.y && bmax.y >= qmin.y) &&
-           (bmin.z <= qmax.z && bmax.z >= qmin.z);
+// Slab-test the ray against node's child boxes grown by pad, over t in
+// [0, tMax]. Returns a bit mask of the children hit and their entry t.
+static int SlabTest4(const BVH4Node& node, const SlabRay& r, float pad, float tMax, float tNear[4]) {
+#if HOTONES_PHYSICS_SSE
+    const __m128 p  = _mm_set1_ps(pad);
+    auto slab = [&](const float* mn, const float* mx, float o, float inv, __m128& lo, __m128& hi) {
+        const __m128 vo = _mm_set1_ps(o), vi = _mm_set1_ps(inv);
+        const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(_mm_load_ps(mn), p), vo), vi);
+        const __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(_mm_load_ps(mx), p), vo), vi);
+        lo = _mm_max_ps(lo, _mm_min_ps(t1, t2));
+        hi = _mm_min_ps(hi, _mm_max_ps(t1, t2));
+    };
+    __m128 lo = _mm_setzero_ps(), hi = _mm_set1_ps(tMax);
+    slab(node.bminX, node.bmaxX, r.o.x, r.inv.x, lo, hi);
+    slab(node.bminY, node.bmaxY, r.o.y, r.inv.y, lo, hi);
+    slab(node.bminZ, node.bmaxZ, r.o.z, r.inv.z, lo, hi);
+    _mm_storeu_ps(tNear, lo);
+    return _mm_movemask_ps(_mm_cmple_ps(lo, hi)) & ((1 << node.count) - 1);
+#else
+    int mask = 0;
+    for (int i = 0; i < node.count; ++i) {
+        float lo = 0.f, hi = tMax;
+        auto slab = [&](float mn, float mx, float o, float inv) {
+            const float t1 = (mn - pad - o) * inv, t2 = (mx + pad - o) * inv;
+            lo = fmaxf(lo, fminf(t1, t2));
+            hi = fminf(hi, fmaxf(t1, t2));
+        };
+        slab(node.bminX[i], node.bmaxX[i], r.o.x, r.inv.x);
+        slab(node.bminY[i], node.bmaxY[i], r.o.y, r.inv.y);
+        slab(node.bminZ[i], node.bmaxZ[i], r.o.z, r.inv.z);
+        tNear[i] = lo;
+        if (lo <= hi) mask |= 1 << i;
+    }
+    return mask;
+#endif
+}
+
+// Bit mask of node's children whose boxes overlap [qmin, qmax].
+static int OverlapTest4(const BVH4Node& node, Vector3 qmin, Vector3 qmax) {
+#if HOTONES_PHYSICS_SSE
+    auto axis = [](const float* mn, const float* mx, float qlo, float qhi) {
+        return _mm_and_ps(_mm_cmple_ps(_mm_load_ps(mn), _mm_set1_ps(qhi)),
+                          _mm_cmpge_ps(_mm_load_ps(mx), _mm_set1_ps(qlo)));
+    };
+    const __m128 m = _mm_and_ps(axis(node.bminX, node.bmaxX, qmin.x, qmax.x),
+                     _mm_and_ps(axis(node.bminY, node.bmaxY, qmin.y, qmax.y),
+                                axis(node.bminZ, node.bmaxZ, qmin.z, qmax.z)));
+    return _mm_movemask_ps(m) & ((1 << node.count) - 1);
+#else
+    int mask = 0;
+    for (int i = 0; i < node.count; ++i)
+        if (node.bminX[i] <= qmax.x && node.bmaxX[i] >= qmin.x &&
+            node.bminY[i] <= qmax.y && node.bmaxY[i] >= qmin.y &&
+            node.bminZ[i] <= qmax.z && node.bmaxZ[i] >= qmin.z) mask |= 1 << i;
+    return mask;
+#endif
 }
 
-// Traverse BVH for sweep; returns earliest t.
-static void SweepNodeBVH(const BVH& bvh, int nodeIdx,
+// Order the children in mask farthest first, so pushing them in that order
+// pops the nearest (smallest tNear) first. Returns how many were ordered.
+static int SortFarFirst(int mask, int count, const float tNear[4], int order[4]) {
+    float key[4];
+    int   n = 0;
+    for (int i = 0; i < count; ++i) {
+        if (!(mask & (1 << i))) continue;
+        int j = n++;
+        while (j > 0 && key[j - 1] < tNear[i]) { key[j] = key[j - 1]; order[j] = order[j - 1]; --j; }
+        key[j] = tNear[i]; order[j] = i;
+    }
+    return n;
+}
+
+static void PushNearFirst(NodeStack<int32_t>& stack, const BVH4Node& node, int mask, const float tNear[4]) {
+    int order[4];
+    const int n = SortFarFirst(mask, node.count, tNear, order);
+    for (int i = 0; i < n; ++i) stack.Push(node.child[order[i]]);
+}
+
+// Traverse BVH for sweep; returns earliest t. The segment start→end is
+// slab-tested against child boxes grown by radius, cut off at the best hit
+// so far, nearest child first.
+static void SweepNodeBVH(const BVH& bvh,
                           Vector3 start, Vector3 end, float radius,
                           float& bestT, Vector3& bestN) {
-    if (nodeIdx < 0 || nodeIdx >= (int)bvh.nodes.size()) return;
-    const BVHNode& node = bvh.nodes[nodeIdx];
-
-    // Expand node AABB by radius and do a quick overlap test with the swept AABB of the sphere
-    Vector3 swMin = { fminf(start.x, end.x) - radius,
-                      fminf(start.y, end.y) - radius,
-                      fminf(start.z, end.z) - radius };
-    Vector3 swMax = { fmaxf(start.x, end.x) + radius,
-                      fmaxf(start.y, end.y) + radius,
-                      fmaxf(start.z, end.z) + radius };
-    if (!AabbOverlap(node.bmin, node.bmax, swMin, swMax)) return;
-
-    if (node.rightChild == -1) {
-        // Leaf — test each triangle
-        for (int i = node.triStart; i < node.triStart + node.triCount; ++i) {
-            const Tri& tri = bvh.tris[i];
-            Vector3 n;
-            float t = SweepSphereTriangle(start, end, radius, tri.a, tri.b, tri.c, n);
-            if (t < bestT) { bestT = t; bestN = n; }
+    const SlabRay ray(start, v3sub(end, start));
+    const float   pad = radius + 1e-4f;
+    NodeStack<int32_t> stack(bvh);
+    stack.Push(0);
+    while (!stack.Empty()) {
+        const int32_t idx = stack.Pop();
+        if (idx < 0) {
+            // Leaf — test each triangle
+            const BVH4Leaf& leaf = bvh.leaves[~idx];
+            for (int i = leaf.triStart; i < leaf.triStart + leaf.triCount; ++i) {
+                const Tri& tri = bvh.tris[i];
+                Vector3 n;
+                float t = SweepSphereTriangle(start, end, radius, tri.a, tri.b, tri.c, n);
+                if (t < bestT) { bestT = t; bestN = n; }
+            }
+            continue;
         }
-        return;
+        const BVH4Node& node = bvh.wide[idx];
+        float tNear[4];
+        const int mask = SlabTest4(node, ray, pad, fminf(bestT, 1.f + 1e-6f), tNear);
+        if (mask) PushNearFirst(stack, node, mask, tNear);
     }
-    // Internal — recurse both children
-    SweepNodeBVH(bvh, nodeIdx + 1,        start, end, radius, bestT, bestN);
-    SweepNodeBVH(bvh, node.rightChild,    start, end, radius, bestT, bestN);
 }
 
 // Traverse BVH for penetration resolution — collect all triangles whose closest
 // point to `center` is within `radius`.
-static void PenetrationNodeBVH(const BVH& bvh, int nodeIdx,
+static void PenetrationNodeBVH(const BVH& bvh,
                                 Vector3 center, float radius,
                                 Vector3& outPush, bool& didPush) {
-    if (nodeIdx < 0 || nodeIdx >= (int)bvh.nodes.size()) return;
-    const BVHNode& node = bvh.nodes[nodeIdx];
-
-    // Quick AABB cull (expand by radius)
-    if (center.x + radius < node.bmin.x || center.x - radius > node.bmax.x ||
-        center.y + radius < node.bmin.y || center.y - radius > node.bmax.y ||
-        center.z + radius < node.bmin.z || center.z - radius > node.bmax.z) return;
-
-    if (node.rightChild == -1) {
-        for (int i = node.triStart; i < node.triStart + node.triCount; ++i) {
+    const Vector3 qmin = { center.x - radius, center.y - radius, center.z - radius };
+    const Vector3 qmax = { center.x + radius, center.y + radius, center.z + radius };
+    NodeStack<int32_t> stack(bvh);
+    stack.Push(0);
+    while (!stack.Empty()) {
+        const int32_t idx = stack.Pop();
+        if (idx >= 0) {
+            // Quick AABB cull of all four children (boxes grown by radius)
+            const BVH4Node& node = bvh.wide[idx];
+            const int mask = OverlapTest4(node, qmin, qmax);
+            for (int i = 0; i < node.count; ++i)
+                if (mask & (1 << i)) stack.Push(node.child[i]);
+            continue;
+        }
+        const BVH4Leaf& leaf = bvh.leaves[~idx];
+        for (int i = leaf.triStart; i < leaf.triStart + leaf.triCount; ++i) {
             const Tri& tri = bvh.tris[i];
             Vector3 closest = ClosestPtTriangle(center, tri.a, tri.b, tri.c);
             Vector3 diff    = v3sub(center, closest);
@@ -367,51 +748,163 @@ static void PenetrationNodeBVH(const BVH& bvh, int nodeIdx,
                 didPush  = true;
             }
         }
-        return;
     }
-    PenetrationNodeBVH(bvh, nodeIdx + 1,     center, radius, outPush, didPush);
-    PenetrationNodeBVH(bvh, node.rightChild, center, radius, outPush, didPush);
 }
 
 // ─── Static mesh registry ─────────────────────────────────────────────────────
 
-struct StaticMeshEntry {
-    int  handle = 0;
-    BVH  bvh;
+// A built, immutable mesh. Shared by the slot that publishes it and by every
+// query still using it; freed by whoever drops the last reference.
+struct StaticMesh {
+    int                      handle = 0;
+    BVH                      bvh;
+    mutable std::atomic<int> refs{1};
 };
 
-static std::vector<StaticMeshEntry> g_staticMeshes;
-static int                          g_nextHandle = 1;
-static std::mutex                   g_meshMutex;
-// Background BVH build queue and worker
-struct BuildTask {
-    int handle = -1;
-    std::vector<Tri> tris;
+static void ReleaseMesh(const StaticMesh* m) {
+    if (m && m->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete m;
+}
+
+// Reference to a StaticMesh held for the duration of a query.
+class MeshRef {
+public:
+    MeshRef() = default;
+    explicit MeshRef(const StaticMesh* m) : m_mesh(m) {}
+    MeshRef(MeshRef&& o) noexcept : m_mesh(std::exchange(o.m_mesh, nullptr)) {}
+    MeshRef(const MeshRef&)            = delete;
+    MeshRef& operator=(const MeshRef&) = delete;
+    MeshRef& operator=(MeshRef&&)      = delete;
+    ~MeshRef() { ReleaseMesh(m_mesh); }
+
+    explicit operator bool() const         { return m_mesh != nullptr; }
+    const StaticMesh* operator->() const   { return m_mesh; }
+
+private:
+    const StaticMesh* m_mesh = nullptr;
 };
-static std::deque<BuildTask>        g_buildQueue;
-static std::mutex                   g_buildMutex;
-static std::condition_variable      g_buildCv;
-static std::thread                  g_buildWorker;
+
+// Handle table. A handle is (generation << MESH_SLOT_BITS) | slot, so
+// looking one up is an index, and a handle whose slot has since been
+// unregistered (and maybe reused) fails the generation check instead of
+// reaching the new mesh.
+//
+// Queries never lock: AcquireMesh pins the slot (readers[epoch]++), loads
+// the mesh pointer, takes a reference and unpins. Writers (register /
+// publish / unregister) serialise on g_meshMutex; to replace a slot's mesh
+// they swap the pointer, flip the slot's epoch and wait for the pins on the
+// previous epoch's counter to drain (a few instructions each) before
+// dropping the old mesh's reference, so a query either got its own
+// reference or never saw the old pointer. Queries that start after the flip
+// pin the other counter, so the wait covers at most one in-flight query per
+// thread, however many keep hitting the slot. The slot array never
+// reallocates.
+static constexpr int      MESH_SLOT_BITS    = 12;
+static constexpr int      MAX_STATIC_MESHES = 1 << MESH_SLOT_BITS;
+static constexpr uint32_t MESH_GEN_MASK     = (1u << (31 - MESH_SLOT_BITS)) - 1;
+
+struct alignas(64) MeshSlot {
+    std::atomic<const StaticMesh*> mesh{nullptr};   // null until built
+    std::atomic<uint32_t>          epoch{0};        // low bit: readers[] new pins go to
+    std::atomic<uint32_t>          readers[2]{};
+    // Guarded by g_meshMutex
+    uint32_t generation = 1;
+    bool     used       = false;
+};
+
+static MeshSlot                     g_meshSlots[MAX_STATIC_MESHES];
+static std::vector<int>             g_freeMeshSlots;     // guarded by g_meshMutex
+static int                          g_meshSlotCount = 0; // guarded by g_meshMutex
+static std::mutex                   g_meshMutex;
+// Background BVH builds. Each mesh is one job on a dedicated pool (so level
+// loads never compete with the ECS for JobPool::Shared()); big meshes split
+// into parallel subtree builds on the same pool.
+static std::unique_ptr<Hotones::Jobs::JobPool> g_buildPool;
 static std::atomic<bool>            g_buildRunning{false};
-// Forward-declare worker function so InitPhysics can start the thread
-namespace Hotones { namespace Physics { void BuildWorkerThread(); } }
+static int                          g_pendingBuilds = 0;   // guarded by g_buildMutex
+static std::mutex                   g_buildMutex;
+static std::condition_variable      g_buildDone;
+
+static int MeshHandle(int slot, uint32_t generation) {
+    return (int)((generation & MESH_GEN_MASK) << MESH_SLOT_BITS) | slot;
+}
+
+// Slot for handle if it is still registered (g_meshMutex held), else null.
+static MeshSlot* RegisteredSlot(int handle) {
+    if (handle <= 0) return nullptr;
+    MeshSlot& s = g_meshSlots[handle & (MAX_STATIC_MESHES - 1)];
+    return s.used && MeshHandle(handle & (MAX_STATIC_MESHES - 1), s.generation) == handle ? &s : nullptr;
+}
+
+// Lock-free lookup: a reference to handle's built mesh, or an empty ref if
+// the handle is unknown, stale or still building.
+static MeshRef AcquireMesh(int handle) {
+    if (handle <= 0) return {};
+    MeshSlot& s = g_meshSlots[handle & (MAX_STATIC_MESHES - 1)];
+    std::atomic<uint32_t>& pins = s.readers[s.epoch.load() & 1u];
+    pins.fetch_add(1);
+    const StaticMesh* m = s.mesh.load();
+    if (m && m->handle == handle) m->refs.fetch_add(1, std::memory_order_relaxed);
+    else                          m = nullptr;
+    pins.fetch_sub(1, std::memory_order_release);
+    return MeshRef(m);
+}
+
+// Swap slot's mesh for replacement and drop the old one once no query can
+// still be acquiring it (g_meshMutex held).
+static void ReplaceMesh(MeshSlot& s, const StaticMesh* replacement) {
+    const StaticMesh* old = s.mesh.exchange(replacement);
+    // A query pinning the old counter after this point loads replacement.
+    std::atomic<uint32_t>& pins = s.readers[s.epoch.fetch_xor(1u) & 1u];
+    while (pins.load() != 0) std::this_thread::yield();
+    ReleaseMesh(old);
+}
+
+// Retire slot's handle and return the slot to the free list (g_meshMutex held).
+static void FreeMeshSlot(int slot) {
+    MeshSlot& s = g_meshSlots[slot];
+    ReplaceMesh(s, nullptr);
+    s.used       = false;
+    s.generation = (s.generation + 1) & MESH_GEN_MASK;
+    if (s.generation == 0) s.generation = 1;   // keep handles positive
+    g_freeMeshSlots.push_back(slot);
+}
+
+// Build the BVH for handle and publish it (dropped if the mesh was
+// unregistered meanwhile).
+static void BuildStaticMesh(int handle, std::vector<Tri>&& tris, Hotones::Jobs::JobPool* pool) {
+    auto* built = new StaticMesh;
+    built->handle = handle;
+    built->bvh.Build(std::move(tris), pool);
+
+    std::lock_guard<std::mutex> lk(g_meshMutex);
+    MeshSlot* s = RegisteredSlot(handle);
+    if (!s) { ReleaseMesh(built); return; }
+    ReplaceMesh(*s, built);
+    TraceLog(LOG_INFO, "[Physics] Built mesh handle=%d tris=%zu bvh4_nodes=%zu depth=%d",
+             handle, built->bvh.tris.size(), built->bvh.wide.size(), built->bvh.wideDepth);
+}
 
 namespace Hotones { namespace Physics {
 
 bool InitPhysics() {
     if (!g_buildRunning.load()) {
+        g_buildPool = std::make_unique<Jobs::JobPool>();
         g_buildRunning.store(true);
-        g_buildWorker = std::thread(BuildWorkerThread);
-        TraceLog(LOG_INFO, "[Physics] BVH worker thread started");
+        TraceLog(LOG_INFO, "[Physics] BVH build pool started (%u workers)", g_buildPool->WorkerCount());
     }
     return true;
 }
 
 void ShutdownPhysics() {
+    // Queued builds see g_buildRunning == false and skip; the pool's
+    // destructor waits for any build already running.
     g_buildRunning.store(false);
-    g_buildCv.notify_all();
-    if (g_buildWorker.joinable()) g_buildWorker.join();
-    g_staticMeshes.clear();
+    g_buildPool.reset();
+    {
+        std::lock_guard<std::mutex> lk(g_meshMutex);
+        for (int slot = 0; slot < g_meshSlotCount; ++slot)
+            if (g_meshSlots[slot].used) FreeMeshSlot(slot);
+    }
     TraceLog(LOG_INFO, "[Physics] Shutdown complete");
 }
 
@@ -447,85 +940,85 @@ int RegisterStaticMeshFromModel(const Model& model, const Vector3& position) {
 
     if (tris.empty()) return -1;
 
-    // Create a placeholder entry immediately so callers get a handle
-    StaticMeshEntry entry;
-    entry.handle = g_nextHandle++;
+    // Reserve a slot immediately so callers get a handle
+    int handle;
     {
         std::lock_guard<std::mutex> lk(g_meshMutex);
-        g_staticMeshes.push_back(std::move(entry));
+        int slot;
+        if (!g_freeMeshSlots.empty()) {
+            slot = g_freeMeshSlots.back();
+            g_freeMeshSlots.pop_back();
+        } else if (g_meshSlotCount < MAX_STATIC_MESHES) {
+            slot = g_meshSlotCount++;
+        } else {
+            TraceLog(LOG_WARNING, "[Physics] Static mesh limit (%d) reached", MAX_STATIC_MESHES);
+            return -1;
+        }
+        g_meshSlots[slot].used = true;
+        handle = MeshHandle(slot, g_meshSlots[slot].generation);
+    }
+    const size_t triCount = tris.size();
+
+    // Without a build pool (InitPhysics not called) build on the spot.
+    if (!g_buildRunning.load()) {
+        BuildStaticMesh(handle, std::move(tris), nullptr);
+        return handle;
     }
 
     // Queue building the BVH in the background to avoid stalls during loading
-    BuildTask task;
-    task.handle = g_nextHandle - 1;
-    task.tris = std::move(tris);
     {
         std::lock_guard<std::mutex> lk(g_buildMutex);
-        g_buildQueue.push_back(std::move(task));
+        ++g_pendingBuilds;
     }
-    g_buildCv.notify_one();
+    Jobs::JobPool* pool = g_buildPool.get();
+    auto shared = std::make_shared<std::vector<Tri>>(std::move(tris));
+    pool->Submit([handle, shared, pool] {
+        if (g_buildRunning.load()) BuildStaticMesh(handle, std::move(*shared), pool);
+        {
+            std::lock_guard<std::mutex> lk(g_buildMutex);
+            --g_pendingBuilds;
+        }
+        g_buildDone.notify_all();
+    });
 
-    TraceLog(LOG_INFO, "[Physics] Queued mesh build handle=%d tris=%zu", (g_nextHandle - 1), task.tris.size());
-    return (g_nextHandle - 1);
+    TraceLog(LOG_INFO, "[Physics] Queued mesh build handle=%d tris=%zu", handle, triCount);
+    return handle;
 }
 
 void UnregisterStaticMesh(int handle) {
+    // Queries already holding the mesh finish on it; it is freed after them.
     std::lock_guard<std::mutex> lk(g_meshMutex);
-    for (auto it = g_staticMeshes.begin(); it != g_staticMeshes.end(); ++it) {
-        if (it->handle == handle) { g_staticMeshes.erase(it); return; }
-    }
+    if (RegisteredSlot(handle)) FreeMeshSlot(handle & (MAX_STATIC_MESHES - 1));
 }
 
-// Background builder thread function
-void BuildWorkerThread() {
-    while (g_buildRunning.load()) {
-        BuildTask task;
-        {
-            std::unique_lock<std::mutex> lk(g_buildMutex);
-            g_buildCv.wait(lk, []{ return !g_buildQueue.empty() || !g_buildRunning.load(); });
-            if (!g_buildRunning.load() && g_buildQueue.empty()) return;
-            task = std::move(g_buildQueue.front());
-            g_buildQueue.pop_front();
-        }
+bool IsMeshReady(int handle) {
+    return (bool)AcquireMesh(handle);
+}
 
-        // Build BVH (potentially expensive) outside mesh lock
-        BVH builtBvh;
-        builtBvh.Build(std::move(task.tris));
+int PendingBuildCount() {
+    std::lock_guard<std::mutex> lk(g_buildMutex);
+    return g_pendingBuilds;
+}
 
-        // Assign the built BVH back to the registered mesh if it still exists
-        {
-            std::lock_guard<std::mutex> lk(g_meshMutex);
-            for (auto &e : g_staticMeshes) {
-                if (e.handle == task.handle) {
-                    e.bvh = std::move(builtBvh);
-                    TraceLog(LOG_INFO, "[Physics] Built mesh handle=%d tris=%zu bvh_nodes=%zu",
-                             e.handle, e.bvh.tris.size(), e.bvh.nodes.size());
-                    break;
-                }
-            }
-        }
-    }
+void WaitForPendingBuilds() {
+    std::unique_lock<std::mutex> lk(g_buildMutex);
+    g_buildDone.wait(lk, [] { return g_pendingBuilds == 0; });
 }
 
-// BVH worker is started by InitPhysics() and stopped by ShutdownPhysics().
 
 bool SweepSphereAgainstStatic(int handle,
                                const Vector3& start, const Vector3& end,
                                float radius,
                                Vector3& hitPos, Vector3& hitNormal, float& t) {
-    // Grab a reference to the entry under lock, then release before traversal
-    const BVH* bvhPtr = nullptr;
-    {
-        std::lock_guard<std::mutex> lk(g_meshMutex);
-        for (const auto& e : g_staticMeshes)
-            if (e.handle == handle) { bvhPtr = &e.bvh; break; }
-        if (!bvhPtr || bvhPtr->nodes.empty()) return false;
-    }
+    // Meshes are immutable once built; the reference keeps this one alive
+    // even if it is unregistered mid-query.
+    const MeshRef mesh = AcquireMesh(handle);
+    if (!mesh) return false;
+    const BVH* bvhPtr = &mesh->bvh;
 
-    // Safe to read without lock since meshes are immutable once registered
     float bestT = FLT_MAX;
     Vector3 bestN = { 0,1,0 };
-    SweepNodeBVH(*bvhPtr, 0, start, end, radius, bestT, bestN);
+    SweepNodeBVH(*bvhPtr, start, end, radius, bestT, bestN);
 
     if (bestT > 1.f + 1e-6f) return false;
 
@@ -538,45 +1031,19 @@ bool SweepSphereAgainstStatic(int handle,
 // New: resolve sphere penetration against a registered static mesh.
 // Pushes `center` out of all overlapping triangles. Returns true if any push occurred.
 bool ResolveSphereAgainstStatic(int handle, Vector3& center, float radius) {
-    const BVH* bvhPtr = nullptr;
-    {
-        std::lock_guard<std::mutex> lk(g_meshMutex);
-        for (const auto& e : g_staticMeshes)
-            if (e.handle == handle) { bvhPtr = &e.bvh; break; }
-        if (!bvhPtr || bvhPtr->nodes.empty()) return false;
-    }
+    const MeshRef mesh = AcquireMesh(handle);
+    if (!mesh) return false;
+    const BVH* bvhPtr = &mesh->bvh;
 
     Vector3 totalPush = {0,0,0};
     bool    pushed    = false;
-    PenetrationNodeBVH(*bvhPtr, 0, center, radius, totalPush, pushed);
+    PenetrationNodeBVH(*bvhPtr, center, radius, totalPush, pushed);
     if (pushed) center = v3add(center, totalPush);
     return pushed;
 }
 
 // ─── Raycasting ───────────────────────────────────────────────────────────────
 
-// Slab-based ray vs AABB. Returns true if the ray [0, tMax] hits the box.
-static bool RayAabb(Vector3 ro, Vector3 rd, Vector3 bmin, Vector3 bmax, float tMax) {
-    float tEnter = 0.f;
-    for (int i = 0; i < 3; ++i) {
-        float o  = (&ro.x)[i];
-        float d  = (&rd.x)[i];
-        float mn = (&bmin.x)[i];
-        float mx = (&bmax.x)[i];
-        if (fabsf(d) < 1e-10f) {
-            if (o < mn || o > mx) return false;
-        } else {
-            float t1 = (mn - o) / d;
-            float t2 = (mx - o) / d;
-            if (t1 > t2) { float tmp = t1; t1 = t2; t2 = tmp; }
-            tEnter = fmaxf(tEnter, t1);
-            tMax   = fminf(tMax,   t2);
-            if (tEnter > tMax) return false;
-        }
-    }
-    return true;
-}
-
 // Möller-Trumbore ray-vs-triangle. Returns t > 0 on hit, FLT_MAX otherwise.
 // Fills outNormal with the face normal flipped toward the ray origin.
 static float RayTriangleMT(Vector3 ro, Vector3 rd,
@@ -604,39 +1071,42 @@ static float RayTriangleMT(Vector3 ro, Vector3 rd,
     return t;
 }
 
-// BVH traversal for raycasting — records the nearest hit.
-static void RaycastNodeBVH(const BVH& bvh, int nodeIdx,
+// BVH traversal for raycasting — records the nearest hit. Children are
+// visited nearest first and culled against the best hit so far.
+static void RaycastNodeBVH(const BVH& bvh,
                              Vector3 ro, Vector3 rd, float& bestT, Vector3& bestN) {
-    if (nodeIdx < 0 || nodeIdx >= (int)bvh.nodes.size()) return;
-    const BVHNode& node = bvh.nodes[nodeIdx];
-    if (!RayAabb(ro, rd, node.bmin, node.bmax, bestT)) return;
-    if (node.rightChild == -1) {
-        // Leaf — test each triangle
-        for (int i = node.triStart; i < node.triStart + node.triCount; ++i) {
-            const Tri& tri = bvh.tris[i];
-            Vector3 n;
-            float t = RayTriangleMT(ro, rd, tri.a, tri.b, tri.c, n);
-            if (t < bestT) { bestT = t; bestN = n; }
+    const SlabRay ray(ro, rd);
+    NodeStack<int32_t> stack(bvh);
+    stack.Push(0);
+    while (!stack.Empty()) {
+        const int32_t idx = stack.Pop();
+        if (idx < 0) {
+            // Leaf — test each triangle
+            const BVH4Leaf& leaf = bvh.leaves[~idx];
+            for (int i = leaf.triStart; i < leaf.triStart + leaf.triCount; ++i) {
+                const Tri& tri = bvh.tris[i];
+                Vector3 n;
+                float t = RayTriangleMT(ro, rd, tri.a, tri.b, tri.c, n);
+                if (t < bestT) { bestT = t; bestN = n; }
+            }
+            continue;
         }
-        return;
+        const BVH4Node& node = bvh.wide[idx];
+        float tNear[4];
+        const int mask = SlabTest4(node, ray, 0.f, bestT, tNear);
+        if (mask) PushNearFirst(stack, node, mask, tNear);
     }
-    RaycastNodeBVH(bvh, nodeIdx + 1,       ro, rd, bestT, bestN);
-    RaycastNodeBVH(bvh, node.rightChild,   ro, rd, bestT, bestN);
 }
 
 bool RaycastAgainstStatic(int handle, const Vector3& origin, const Vector3& dir,
                            float maxDist, Vector3& hitPos, Vector3& hitNormal, float& t) {
-    const BVH* bvhPtr = nullptr;
-    {
-        std::lock_guard<std::mutex> lk(g_meshMutex);
-        for (const auto& e : g_staticMeshes)
-            if (e.handle == handle) { bvhPtr = &e.bvh; break; }
-        if (!bvhPtr || bvhPtr->nodes.empty()) return false;
-    }
+    const MeshRef mesh = AcquireMesh(handle);
+    if (!mesh) return false;
+    const BVH* bvhPtr = &mesh->bvh;
 
     float   bestT = maxDist;
     Vector3 bestN = { 0, 1, 0 };
-    RaycastNodeBVH(*bvhPtr, 0, origin, dir, bestT, bestN);
+    RaycastNodeBVH(*bvhPtr, origin, dir, bestT, bestN);
 
     if (bestT >= maxDist) return false;
 
@@ -646,4 +1116,278 @@ bool RaycastAgainstStatic(int handle, const Vector3& origin, const Vector3& dir,
     return true;
 }
 
+// ─── Batched queries ──────────────────────────────────────────────────────────
+
+// Up to four queries traversed together; lane k is query k of the packet.
+// For sweeps the "ray" is the sphere-centre segment and pad the radius.
+struct alignas(16) RayPacket {
+    float ox[4] = {}, oy[4] = {}, oz[4] = {};
+    float dx[4] = {}, dy[4] = {}, dz[4] = {};
+    float ix[4] = {}, iy[4] = {}, iz[4] = {};   // reciprocal directions (see SlabRay)
+    float pad[4]   = {};
+    float limit[4] = {};         // query length (maxDist, or 1 for sweeps)
+    float best[4]  = {};         // nearest hit so far
+    int   live     = 0;          // lanes holding a query
+
+    void Set(int k, Vector3 o, Vector3 d, float padding, float tLimit, float tBest) {
+        const SlabRay r(o, d);
+        ox[k] = r.o.x;   oy[k] = r.o.y;   oz[k] = r.o.z;
+        dx[k] = d.x;     dy[k] = d.y;     dz[k] = d.z;
+        ix[k] = r.inv.x; iy[k] = r.inv.y; iz[k] = r.inv.z;
+        pad[k] = padding; limit[k] = tLimit; best[k] = tBest;
+        live |= 1 << k;
+    }
+};
+
+struct PacketEntry {
+    int32_t node;
+    int32_t lanes;
+};
+
+#if HOTONES_PHYSICS_SSE
+// LANE_BITS[m] has all bits set in the lanes of mask m (SSE lane select).
+alignas(16) static const uint32_t LANE_BITS[16][4] = {
+    { 0, 0, 0, 0 }, { ~0u, 0, 0, 0 }, { 0, ~0u, 0, 0 }, { ~0u, ~0u, 0, 0 },
+    { 0, 0, ~0u, 0 }, { ~0u, 0, ~0u, 0 }, { 0, ~0u, ~0u, 0 }, { ~0u, ~0u, ~0u, 0 },
+    { 0, 0, 0, ~0u }, { ~0u, 0, 0, ~0u }, { 0, ~0u, 0, ~0u }, { ~0u, ~0u, 0, ~0u },
+    { 0, 0, ~0u, ~0u }, { ~0u, 0, ~0u, ~0u }, { 0, ~0u, ~0u, ~0u }, { ~0u, ~0u, ~0u, ~0u },
+};
+#endif
+
+// Lanes (of those in lanes) whose ray enters child i of node before its best
+// hit. tNear receives the earliest entry among them.
+static int SlabTestPacket(const BVH4Node& node, int i, const RayPacket& p, int lanes, float& tNear) {
+    int mask = 0;
+    tNear = FLT_MAX;
+#if HOTONES_PHYSICS_SSE
+    const __m128 pad = _mm_load_ps(p.pad);
+    auto slab = [&](float mn, float mx, const float* o, const float* inv, __m128& l, __m128& h) {
+        const __m128 vo = _mm_load_ps(o), vi = _mm_load_ps(inv);
+        const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(_mm_set1_ps(mn), pad), vo), vi);
+        const __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(_mm_set1_ps(mx), pad), vo), vi);
+        l = _mm_max_ps(l, _mm_min_ps(t1, t2));
+        h = _mm_min_ps(h, _mm_max_ps(t1, t2));
+    };
+    __m128 l = _mm_setzero_ps();
+    __m128 h = _mm_min_ps(_mm_load_ps(p.best), _mm_load_ps(p.limit));
+    slab(node.bminX[i], node.bmaxX[i], p.ox, p.ix, l, h);
+    slab(node.bminY[i], node.bmaxY[i], p.oy, p.iy, l, h);
+    slab(node.bminZ[i], node.bmaxZ[i], p.oz, p.iz, l, h);
+    const __m128 hitv = _mm_and_ps(_mm_cmple_ps(l, h), _mm_load_ps(reinterpret_cast<const float*>(LANE_BITS[lanes])));
+    mask = _mm_movemask_ps(hitv);
+    if (!mask) return 0;
+    // Earliest entry over the hitting lanes (horizontal min)
+    __m128 m = _mm_or_ps(_mm_and_ps(hitv, l), _mm_andnot_ps(hitv, _mm_set1_ps(FLT_MAX)));
+    m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+    m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+    tNear = _mm_cvtss_f32(m);
+    return mask;
+#else
+    for (int k = 0; k < 4; ++k) {
+        if (!(lanes & (1 << k))) continue;
+        float l = 0.f, h = fminf(p.best[k], p.limit[k]);
+        auto slab = [&](float mn, float mx, float o, float inv) {
+            const float t1 = (mn - p.pad[k] - o) * inv, t2 = (mx + p.pad[k] - o) * inv;
+            l = fmaxf(l, fminf(t1, t2));
+            h = fminf(h, fmaxf(t1, t2));
+        };
+        slab(node.bminX[i], node.bmaxX[i], p.ox[k], p.ix[k]);
+        slab(node.bminY[i], node.bmaxY[i], p.oy[k], p.iy[k]);
+        slab(node.bminZ[i], node.bmaxZ[i], p.oz[k], p.iz[k]);
+        if (l <= h) { mask |= 1 << k; tNear = fminf(tNear, l); }
+    }
+    return mask;
+#endif
+}
+
+// Möller-Trumbore for the lanes of p against one triangle (same maths as
+// RayTriangleMT, one lane per ray). Returns the lanes it hits nearer than
+// their best so far, with their t in tOut.
+static int RayTrianglePacket(const RayPacket& p, int lanes, const Tri& tri, float tOut[4]) {
+#if HOTONES_PHYSICS_SSE
+    const Vector3 e1 = v3sub(tri.b, tri.a), e2 = v3sub(tri.c, tri.a);
+    auto splat = [](float f) { return _mm_set1_ps(f); };
+    const __m128 dx = _mm_load_ps(p.dx), dy = _mm_load_ps(p.dy), dz = _mm_load_ps(p.dz);
+    // h = d × e2, a = e1 · h
+    const __m128 hx = _mm_sub_ps(_mm_mul_ps(dy, splat(e2.z)), _mm_mul_ps(dz, splat(e2.y)));
+    const __m128 hy = _mm_sub_ps(_mm_mul_ps(dz, splat(e2.x)), _mm_mul_ps(dx, splat(e2.z)));
+    const __m128 hz = _mm_sub_ps(_mm_mul_ps(dx, splat(e2.y)), _mm_mul_ps(dy, splat(e2.x)));
+    const __m128 a  = _mm_add_ps(_mm_add_ps(_mm_mul_ps(splat(e1.x), hx), _mm_mul_ps(splat(e1.y), hy)),
+                                 _mm_mul_ps(splat(e1.z), hz));
+    const __m128 absA = _mm_andnot_ps(splat(-0.f), a);
+    __m128 ok = _mm_cmpge_ps(absA, splat(1e-8f));
+    const __m128 f  = _mm_div_ps(splat(1.f), a);
+    // s = o - a, u = f (s · h)
+    const __m128 sx = _mm_sub_ps(_mm_load_ps(p.ox), splat(tri.a.x));
+    const __m128 sy = _mm_sub_ps(_mm_load_ps(p.oy), splat(tri.a.y));
+    const __m128 sz = _mm_sub_ps(_mm_load_ps(p.oz), splat(tri.a.z));
+    const __m128 u  = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, hx), _mm_mul_ps(sy, hy)),
+                                               _mm_mul_ps(sz, hz)));
+    ok = _mm_and_ps(ok, _mm_and_ps(_mm_cmpge_ps(u, _mm_setzero_ps()), _mm_cmple_ps(u, splat(1.f))));
+    // q = s × e1, v = f (d · q), t = f (e2 · q)
+    const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, splat(e1.z)), _mm_mul_ps(sz, splat(e1.y)));
+    const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, splat(e1.x)), _mm_mul_ps(sx, splat(e1.z)));
+    const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, splat(e1.y)), _mm_mul_ps(sy, splat(e1.x)));
+    const __m128 v  = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)),
+                                               _mm_mul_ps(dz, qz)));
+    ok = _mm_and_ps(ok, _mm_and_ps(_mm_cmpge_ps(v, _mm_setzero_ps()),
+                                   _mm_cmple_ps(_mm_add_ps(u, v), splat(1.f))));
+    const __m128 t  = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(splat(e2.x), qx), _mm_mul_ps(splat(e2.y), qy)),
+                                               _mm_mul_ps(splat(e2.z), qz)));
+    ok = _mm_and_ps(ok, _mm_and_ps(_mm_cmpge_ps(t, splat(1e-6f)), _mm_cmplt_ps(t, _mm_load_ps(p.best))));
+    _mm_storeu_ps(tOut, t);
+    return _mm_movemask_ps(ok) & lanes;
+#else
+    int mask = 0;
+    for (int k = 0; k < 4; ++k) {
+        if (!(lanes & (1 << k))) continue;
+        Vector3 n;
+        tOut[k] = RayTriangleMT({ p.ox[k], p.oy[k], p.oz[k] }, { p.dx[k], p.dy[k], p.dz[k] },
+                                tri.a, tri.b, tri.c, n);
+        if (tOut[k] < p.best[k]) mask |= 1 << k;
+    }
+    return mask;
+#endif
+}
+
+// Walk the tree once for every live lane of p: a child is visited if any
+// lane's ray reaches it, carrying just those lanes, nearest first.
+// leafFn(leaf, lanes) tests the leaf's triangles and lowers p.best.
+template<typename LeafFn>
+static void TraversePacket(const BVH& bvh, RayPacket& p, LeafFn&& leafFn) {
+    NodeStack<PacketEntry> stack(bvh);
+    stack.Push({ 0, p.live });
+    while (!stack.Empty()) {
+        const PacketEntry e = stack.Pop();
+        if (e.node < 0) { leafFn(bvh.leaves[~e.node], e.lanes); continue; }
+
+        const BVH4Node& node = bvh.wide[e.node];
+        float tNear[4];
+        int   lanes[4];
+        int   mask = 0;
+        for (int i = 0; i < node.count; ++i) {
+            lanes[i] = SlabTestPacket(node, i, p, e.lanes, tNear[i]);
+            if (lanes[i]) mask |= 1 << i;
+        }
+        int order[4];
+        const int n = SortFarFirst(mask, node.count, tNear, order);
+        for (int i = 0; i < n; ++i) stack.Push({ node.child[order[i]], lanes[order[i]] });
+    }
+}
+
+// Packets only pay off when their rays visit the same nodes; rays whose
+// direction signs differ on any axis are traversed one at a time instead.
+static bool SameOctant(const Vector3* dirs, int n) {
+    auto octant = [](Vector3 d) { return (d.x < 0.f) | (d.y < 0.f) << 1 | (d.z < 0.f) << 2; };
+    for (int k = 1; k < n; ++k)
+        if (octant(dirs[k]) != octant(dirs[0])) return false;
+    return true;
+}
+
+int RaycastBatch(int handle, const RayQuery* rays, int count, QueryHit* hits) {
+    for (int i = 0; i < count; ++i) hits[i] = QueryHit{};
+    const MeshRef mesh = AcquireMesh(handle);
+    if (!mesh || count <= 0) return 0;
+    const BVH* bvhPtr = &mesh->bvh;
+
+    int hitCount = 0;
+    for (int base = 0; base < count; base += 4) {
+        const int n = std::min(4, count - base);
+        const RayQuery* q = rays + base;
+        Vector3 dirs[4];
+        for (int k = 0; k < n; ++k) dirs[k] = q[k].dir;
+
+        float   bestT[4];
+        Vector3 bestN[4];
+        if (n > 1 && SameOctant(dirs, n)) {
+            RayPacket p;
+            for (int k = 0; k < n; ++k) p.Set(k, q[k].origin, q[k].dir, 0.f, q[k].maxDist, q[k].maxDist);
+            TraversePacket(*bvhPtr, p, [&](const BVH4Leaf& leaf, int lanes) {
+                for (int i = leaf.triStart; i < leaf.triStart + leaf.triCount; ++i) {
+                    const Tri& tri = bvhPtr->tris[i];
+                    float t[4];
+                    const int hit = RayTrianglePacket(p, lanes, tri, t);
+                    if (!hit) continue;
+                    // Face normal flipped toward each hitting ray, as RayTriangleMT does
+                    const Vector3 nrm = v3norm(v3cross(v3sub(tri.b, tri.a), v3sub(tri.c, tri.a)));
+                    for (int k = 0; k < n; ++k) {
+                        if (!(hit & (1 << k))) continue;
+                        p.best[k] = t[k];
+                        bestN[k]  = v3dot(nrm, q[k].dir) > 0.f ? v3scale(nrm, -1.f) : nrm;
+                    }
+                }
+            });
+            for (int k = 0; k < n; ++k) bestT[k] = p.best[k];
+        } else {
+            for (int k = 0; k < n; ++k) {
+                bestT[k] = q[k].maxDist;
+                RaycastNodeBVH(*bvhPtr, q[k].origin, q[k].dir, bestT[k], bestN[k]);
+            }
+        }
+
+        for (int k = 0; k < n; ++k) {
+            if (bestT[k] >= q[k].maxDist) continue;
+            QueryHit& h = hits[base + k];
+            h.hit    = true;
+            h.t      = bestT[k];
+            h.normal = bestN[k];
+            h.pos    = v3add(q[k].origin, v3scale(q[k].dir, bestT[k]));
+            ++hitCount;
+        }
+    }
+    return hitCount;
+}
+
+int SweepSphereBatch(int handle, const SweepQuery* sweeps, int count, QueryHit* hits) {
+    for (int i = 0; i < count; ++i) hits[i] = QueryHit{};
+    const MeshRef mesh = AcquireMesh(handle);
+    if (!mesh || count <= 0) return 0;
+    const BVH* bvhPtr = &mesh->bvh;
+
+    const float limit = 1.f + 1e-6f;
+    int hitCount = 0;
+    for (int base = 0; base < count; base += 4) {
+        const int n = std::min(4, count - base);
+        const SweepQuery* q = sweeps + base;
+        Vector3 dirs[4];
+        for (int k = 0; k < n; ++k) dirs[k] = v3sub(q[k].end, q[k].start);
+
+        float   bestT[4];
+        Vector3 bestN[4];
+        if (n > 1 && SameOctant(dirs, n)) {
+            RayPacket p;
+            for (int k = 0; k < n; ++k) p.Set(k, q[k].start, dirs[k], q[k].radius + 1e-4f, limit, FLT_MAX);
+            TraversePacket(*bvhPtr, p, [&](const BVH4Leaf& leaf, int lanes) {
+                for (int i = leaf.triStart; i < leaf.triStart + leaf.triCount; ++i) {
+                    const Tri& tri = bvhPtr->tris[i];
+                    for (int k = 0; k < n; ++k) {
+                        if (!(lanes & (1 << k))) continue;
+                        Vector3 nrm;
+                        const float t = SweepSphereTriangle(q[k].start, q[k].end, q[k].radius,
+                                                            tri.a, tri.b, tri.c, nrm);
+                        if (t < p.best[k]) { p.best[k] = t; bestN[k] = nrm; }
+                    }
+                }
+            });
+            for (int k = 0; k < n; ++k) bestT[k] = p.best[k];
+        } else {
+            for (int k = 0; k < n; ++k) {
+                bestT[k] = FLT_MAX;
+                SweepNodeBVH(*bvhPtr, q[k].start, q[k].end, q[k].radius, bestT[k], bestN[k]);
+            }
+        }
+
+        for (int k = 0; k < n; ++k) {
+            if (bestT[k] > limit) continue;
+            QueryHit& h = hits[base + k];
+            h.hit    = true;
+            h.t      = bestT[k];
+            h.normal = bestN[k];
+            h.pos    = v3add(q[k].start, v3scale(dirs[k], bestT[k]));
+            ++hitCount;
+        }
+    }
+    return hitCount;
+}
+
 }} // namespace Hotones::Physics
@@ -29,6 +29,11 @@ void Player::AttachWorld(std::shared_ptr<CollidableModel> world) {
 void Player::Update() {
     if (!m_attachedCamera) return;
 
+    // Hold the player in place until the world's collision mesh has been
+    // built (in the background, after the scene loaded it) so they cannot
+    // fall through the floor on the first frames.
+    if (m_worldModel && !m_worldModel->IsCollisionReady()) return;
+
     Vector2 mouseDelta = Hotones::Input::GetMouseDelta();
     lookRotation.x -= mouseDelta.x * sensitivity.x;
     lookRotation.y += mouseDelta.y * sensitivity.y;
@@ -389,6 +389,37 @@ void CupLoader::firePlayerLeft(uint8_t id)
     lua_pop(L, 1);
 }
 
+void CupLoader::fireEntitiesExpired(std::span<const uint32_t> ids)
+{
+    fireEntityList("onEntitiesExpired", ids);
+}
+
+void CupLoader::fireEntitiesDied(std::span<const uint32_t> ids)
+{
+    fireEntityList("onEntitiesDied", ids);
+}
+
+void CupLoader::fireEntityList(const char* method, std::span<const uint32_t> ids)
+{
+    if (ids.empty() || !L || m_classRef == LUA_NOREF) return;
+    lua_rawgeti(L, LUA_REGISTRYINDEX, m_classRef);
+    lua_getfield(L, -1, method);
+    if (!lua_isfunction(L, -1)) { lua_pop(L, 2); return; }
+    lua_pushvalue(L, -2);
+    lua_createtable(L, static_cast<int>(ids.size()), 0);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        lua_pushinteger(L, static_cast<lua_Integer>(ids[i]));
+        lua_rawseti(L, -2, static_cast<lua_Integer>(i + 1));
+    }
+    if (lua_pcall(L, 2, 0, 0) != LUA_OK) {
+        const char* err = lua_tostring(L, -1);
+        TraceLog(LOG_ERROR, "[CupLoader] %s() error: %s", method, (err ? err : "<unknown>"));
+        m_lastLuaError = err ? err : "<unknown>";
+        lua_pop(L, 1);
+    }
+    lua_pop(L, 1);
+}
+
 bool CupLoader::callMethod(const char* method, int /*nargs*/)
 {
     if (!L || m_classRef == LUA_NOREF) return false;
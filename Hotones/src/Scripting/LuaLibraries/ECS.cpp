@@ -3,6 +3,16 @@
 #include <GFX/Player.hpp>
 #include "../../include/Scripting/LuaLoader/ECS.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 // ── Module-level state ────────────────────────────────────────────────────────
 // These pointers are set by the scene before registering / every time the
 // active world changes.  All Lua bindings below check for nullptr.
@@ -12,10 +22,12 @@ namespace Hotones::Scripting::LuaLoader {
 namespace {
     static ECS::Registry* g_registry    = nullptr;
     static Hotones::Player* g_ecsPlayer = nullptr;
+    static bool             g_restored  = false;
 } // anonymous namespace
 
 void setECSRegistry(ECS::Registry* reg)      { g_registry  = reg; }
 void setECSLocalPlayer(Hotones::Player* p)   { g_ecsPlayer = p;   }
+void setECSRestored(bool restored)           { g_restored  = restored; }
 
 // ── Helpers ───────────────────────────────────────────────────────────────────
 
@@ -26,6 +38,13 @@ static inline bool registryReady(lua_State* L)
     return false;
 }
 
+// Read-only view of the registry — lookups through it do not mark the
+// component as changed, so getters do not trip Changed<T> queries.
+static inline const ECS::Registry& readRegistry()
+{
+    return *g_registry;
+}
+
 static inline ECS::EntityId toEntityId(lua_State* L, int idx)
 {
     return static_cast<ECS::EntityId>(luaL_checkinteger(L, idx));
@@ -56,6 +75,13 @@ static int l_destroy(lua_State* L)
     return 0;
 }
 
+// ecs.isRestored() → bool
+static int l_isRestored(lua_State* L)
+{
+    lua_pushboolean(L, g_restored ? 1 : 0);
+    return 1;
+}
+
 // ecs.isAlive(id) → bool
 static int l_isAlive(lua_State* L)
 {
@@ -77,10 +103,8 @@ static int l_setPos(lua_State* L)
     if (!g_registry->IsAlive(id)) return 0;
 
     // If this is a player entity, teleport the engine player directly.
-    if (g_registry->HasComponent<ECS::PlayerComponent>(id)) {
-        auto& pc = g_registry->GetComponent<ECS::PlayerComponent>(id);
-        if (pc.player) pc.player->body.position = {x, y, z};
-    }
+    if (auto* pc = g_registry->TryGetComponent<ECS::PlayerComponent>(id))
+        if (pc->player) pc->player->body.position = {x, y, z};
 
     g_registry->GetOrAdd<ECS::TransformComponent>(id).position = {x, y, z};
     return 0;
@@ -94,10 +118,9 @@ static int l_getPos(lua_State* L)
     if (!g_registry->IsAlive(id)) return push3zeros(L);
 
     // Player entity: read live position from the engine Player.
-    if (g_registry->HasComponent<ECS::PlayerComponent>(id)) {
-        auto& pc = g_registry->GetComponent<ECS::PlayerComponent>(id);
-        if (pc.player) {
-            auto& p = pc.player->body.position;
+    if (const auto* pc = readRegistry().TryGetComponent<ECS::PlayerComponent>(id)) {
+        if (pc->player) {
+            auto& p = pc->player->body.position;
             lua_pushnumber(L, p.x);
             lua_pushnumber(L, p.y);
             lua_pushnumber(L, p.z);
@@ -105,11 +128,10 @@ static int l_getPos(lua_State* L)
         }
     }
 
-    if (g_registry->HasComponent<ECS::TransformComponent>(id)) {
-        auto& t = g_registry->GetComponent<ECS::TransformComponent>(id);
-        lua_pushnumber(L, t.position.x);
-        lua_pushnumber(L, t.position.y);
-        lua_pushnumber(L, t.position.z);
+    if (const auto* t = readRegistry().TryGetComponent<ECS::TransformComponent>(id)) {
+        lua_pushnumber(L, t->position.x);
+        lua_pushnumber(L, t->position.y);
+        lua_pushnumber(L, t->position.z);
         return 3;
     }
     return push3zeros(L);
@@ -146,11 +168,10 @@ static int l_getVelocity(lua_State* L)
 {
     if (!g_registry) return push3zeros(L);
     auto id = toEntityId(L, 1);
-    if (g_registry->IsAlive(id) && g_registry->HasComponent<ECS::VelocityComponent>(id)) {
-        auto& v = g_registry->GetComponent<ECS::VelocityComponent>(id).linear;
-        lua_pushnumber(L, v.x);
-        lua_pushnumber(L, v.y);
-        lua_pushnumber(L, v.z);
+    if (const auto* vel = readRegistry().TryGetComponent<ECS::VelocityComponent>(id)) {
+        lua_pushnumber(L, vel->linear.x);
+        lua_pushnumber(L, vel->linear.y);
+        lua_pushnumber(L, vel->linear.z);
         return 3;
     }
     return push3zeros(L);
@@ -164,8 +185,7 @@ static int l_setTag(lua_State* L)
     if (!registryReady(L)) return 0;
     auto        id   = toEntityId(L, 1);
     const char* name = luaL_checkstring(L, 2);
-    if (!g_registry->IsAlive(id)) return 0;
-    g_registry->GetOrAdd<ECS::TagComponent>(id).name = name;
+    g_registry->SetTag(id, name);
     return 0;
 }
 
@@ -174,13 +194,40 @@ static int l_getTag(lua_State* L)
 {
     if (!g_registry) { lua_pushstring(L, ""); return 1; }
     auto id = toEntityId(L, 1);
-    if (g_registry->IsAlive(id) && g_registry->HasComponent<ECS::TagComponent>(id))
-        lua_pushstring(L, g_registry->GetComponent<ECS::TagComponent>(id).name.c_str());
+    if (const auto* tag = readRegistry().TryGetComponent<ECS::TagComponent>(id))
+        lua_pushstring(L, tag->name.c_str());
     else
         lua_pushstring(L, "");
     return 1;
 }
 
+// ecs.findByTag(name) → id | nil
+static int l_findByTag(lua_State* L)
+{
+    const char* name = luaL_checkstring(L, 1);
+    const ECS::EntityId id = g_registry ? readRegistry().FindByTag(name) : ECS::INVALID_ENTITY;
+    if (id == ECS::INVALID_ENTITY) lua_pushnil(L);
+    else                           lua_pushinteger(L, static_cast<lua_Integer>(id));
+    return 1;
+}
+
+// ecs.findAllByTag(name) → { id, ... }
+static int l_findAllByTag(lua_State* L)
+{
+    const char* name = luaL_checkstring(L, 1);
+    // Sized first and filled from the index afterwards: creating the table
+    // may run the GC (and finalizers that retag or destroy entities).
+    const size_t count = g_registry ? readRegistry().Tagged(name).size() : 0;
+    lua_createtable(L, static_cast<int>(count), 0);
+    if (!g_registry) return 1;
+    const std::span<const ECS::EntityId> ids = readRegistry().Tagged(name);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        lua_pushinteger(L, static_cast<lua_Integer>(ids[i]));
+        lua_rawseti(L, -2, static_cast<lua_Integer>(i + 1));
+    }
+    return 1;
+}
+
 // ── Health ────────────────────────────────────────────────────────────────────
 
 // ecs.addHealth(id, maxHp)  — creates HealthComponent; current = max
@@ -190,14 +237,9 @@ static int l_addHealth(lua_State* L)
     auto  id    = toEntityId(L, 1);
     float maxHp = static_cast<float>(luaL_checknumber(L, 2));
     if (!g_registry->IsAlive(id)) return 0;
-    if (!g_registry->HasComponent<ECS::HealthComponent>(id)) {
-        auto& h = g_registry->AddComponent<ECS::HealthComponent>(id);
-        h.max = h.current = maxHp;
-    } else {
-        auto& h  = g_registry->GetComponent<ECS::HealthComponent>(id);
-        h.max    = maxHp;
-        h.current = maxHp;
-    }
+    auto& h   = g_registry->GetOrAdd<ECS::HealthComponent>(id);
+    h.max     = maxHp;
+    h.current = maxHp;
     return 0;
 }
 
@@ -206,10 +248,9 @@ static int l_getHealth(lua_State* L)
 {
     if (!g_registry) { lua_pushnumber(L, 0); lua_pushnumber(L, 0); return 2; }
     auto id = toEntityId(L, 1);
-    if (g_registry->IsAlive(id) && g_registry->HasComponent<ECS::HealthComponent>(id)) {
-        const auto& h = g_registry->GetComponent<ECS::HealthComponent>(id);
-        lua_pushnumber(L, h.current);
-        lua_pushnumber(L, h.max);
+    if (const auto* h = readRegistry().TryGetComponent<ECS::HealthComponent>(id)) {
+        lua_pushnumber(L, h->current);
+        lua_pushnumber(L, h->max);
     } else {
         lua_pushnumber(L, 0); lua_pushnumber(L, 0);
     }
@@ -222,8 +263,8 @@ static int l_damage(lua_State* L)
     if (!registryReady(L)) return 0;
     auto  id  = toEntityId(L, 1);
     float amt = static_cast<float>(luaL_checknumber(L, 2));
-    if (g_registry->IsAlive(id) && g_registry->HasComponent<ECS::HealthComponent>(id))
-        g_registry->GetComponent<ECS::HealthComponent>(id).ApplyDamage(amt);
+    if (auto* h = g_registry->TryGetComponent<ECS::HealthComponent>(id))
+        h->ApplyDamage(amt);
     return 0;
 }
 
@@ -233,8 +274,8 @@ static int l_heal(lua_State* L)
     if (!registryReady(L)) return 0;
     auto  id  = toEntityId(L, 1);
     float amt = static_cast<float>(luaL_checknumber(L, 2));
-    if (g_registry->IsAlive(id) && g_registry->HasComponent<ECS::HealthComponent>(id))
-        g_registry->GetComponent<ECS::HealthComponent>(id).Heal(amt);
+    if (auto* h = g_registry->TryGetComponent<ECS::HealthComponent>(id))
+        h->Heal(amt);
     return 0;
 }
 
@@ -242,11 +283,8 @@ static int l_heal(lua_State* L)
 static int l_isDead(lua_State* L)
 {
     if (!g_registry) { lua_pushboolean(L, 0); return 1; }
-    auto id = toEntityId(L, 1);
-    bool dead = g_registry->IsAlive(id)
-             && g_registry->HasComponent<ECS::HealthComponent>(id)
-             && g_registry->GetComponent<ECS::HealthComponent>(id).isDead();
-    lua_pushboolean(L, dead ? 1 : 0);
+    const auto* h = readRegistry().TryGetComponent<ECS::HealthComponent>(toEntityId(L, 1));
+    lua_pushboolean(L, h && h->isDead() ? 1 : 0);
     return 1;
 }
 
@@ -267,9 +305,8 @@ static int l_setLifetime(lua_State* L)
 static int l_getLifetime(lua_State* L)
 {
     if (!g_registry) { lua_pushnumber(L, 0); return 1; }
-    auto id = toEntityId(L, 1);
-    if (g_registry->IsAlive(id) && g_registry->HasComponent<ECS::LifetimeComponent>(id))
-        lua_pushnumber(L, g_registry->GetComponent<ECS::LifetimeComponent>(id).remaining);
+    if (const auto* lt = readRegistry().TryGetComponent<ECS::LifetimeComponent>(toEntityId(L, 1)))
+        lua_pushnumber(L, lt->remaining);
     else
         lua_pushnumber(L, 0);
     return 1;
@@ -320,14 +357,683 @@ static int l_setPlayerBhop(lua_State* L)
     if (!registryReady(L)) return 0;
     auto id      = toEntityId(L, 1);
     bool enabled = lua_toboolean(L, 2) != 0;
-    if (!g_registry->IsAlive(id)) return 0;
-    if (!g_registry->HasComponent<ECS::PlayerComponent>(id)) return 0;
-    auto& pc = g_registry->GetComponent<ECS::PlayerComponent>(id);
-    pc.enableSourceBhop = enabled;
-    if (pc.player) pc.player->SetSourceBhopEnabled(enabled);
+    auto* pc = g_registry->TryGetComponent<ECS::PlayerComponent>(id);
+    if (!pc) return 0;
+    pc->enableSourceBhop = enabled;
+    if (pc->player) pc->player->SetSourceBhopEnabled(enabled);
     return 0;
 }
 
+// ── Hierarchy ────────────────────────────────────────────────────────────────
+
+// ecs.setParent(id, parent)  → bool   (parent nil = detach)
+// The child's Transform becomes relative to the parent; fails on cycles.
+static int l_setParent(lua_State* L)
+{
+    if (!registryReady(L)) { lua_pushboolean(L, 0); return 1; }
+    auto id     = toEntityId(L, 1);
+    auto parent = lua_isnoneornil(L, 2) ? ECS::INVALID_ENTITY : toEntityId(L, 2);
+    lua_pushboolean(L, ECS::SetParent(*g_registry, id, parent));
+    return 1;
+}
+
+// ecs.getParent(id) → parent id, or nil for roots
+static int l_getParent(lua_State* L)
+{
+    if (!g_registry) { lua_pushnil(L); return 1; }
+    const ECS::EntityId parent = ECS::ParentOf(readRegistry(), toEntityId(L, 1));
+    if (parent == ECS::INVALID_ENTITY) lua_pushnil(L);
+    else                               lua_pushinteger(L, static_cast<lua_Integer>(parent));
+    return 1;
+}
+
+// ecs.getWorldPos(id) → x, y, z
+// World-space position as of the last hierarchy update; the local position
+// for entities outside any hierarchy.
+static int l_getWorldPos(lua_State* L)
+{
+    if (!g_registry) return push3zeros(L);
+    auto id = toEntityId(L, 1);
+    if (const auto* w = readRegistry().TryGetComponent<ECS::WorldTransformComponent>(id)) {
+        const Vector3 p = w->Position();
+        lua_pushnumber(L, p.x);
+        lua_pushnumber(L, p.y);
+        lua_pushnumber(L, p.z);
+        return 3;
+    }
+    return l_getPos(L);
+}
+
+// ── Bulk queries ──────────────────────────────────────────────────────────────
+// ecs.query / ecs.each / ecs.update run the entity loop in C++ and move
+// component fields to and from Lua in batches, instead of one Lua→C call
+// (and one pool lookup) per field per entity.
+//
+// Components are named by string; each exposes a fixed set of number fields.
+
+template<typename T>
+struct FieldDef {
+    const char* name;
+    float (*get)(const T&);
+    void  (*set)(T&, float);
+};
+
+struct ComponentBinding {
+    const char*              name;
+    std::vector<const char*> fields;
+    ECS::ComponentTypeId     type;
+    // Copy the entity's fields into out; false if it does not own the component.
+    std::function<bool(const ECS::Registry&, ECS::EntityId, lua_Number* out)> read;
+    // Store the fields marked in `has` (only touches — and marks changed —
+    // the component if a value actually differs).
+    std::function<void(ECS::Registry&, ECS::EntityId, const lua_Number* in, const char* has)> write;
+    // Add the component to prefab: default-constructed, then the fields
+    // marked in `has` set from in.
+    std::function<void(ECS::Prefab&, const lua_Number* in, const char* has)> prefab;
+};
+
+template<typename T>
+static ComponentBinding bindComponent(const char* name, std::vector<FieldDef<T>> defs)
+{
+    ComponentBinding b;
+    b.name = name;
+    b.type = ECS::ComponentTypeOf<T>();
+    for (const auto& d : defs) b.fields.push_back(d.name);
+    b.read = [defs](const ECS::Registry& reg, ECS::EntityId id, lua_Number* out) {
+        const T* c = reg.TryGetComponent<T>(id);
+        if (!c) return false;
+        for (size_t i = 0; i < defs.size(); ++i) out[i] = defs[i].get(*c);
+        return true;
+    };
+    b.write = [defs](ECS::Registry& reg, ECS::EntityId id, const lua_Number* in, const char* has) {
+        const T* current = std::as_const(reg).TryGetComponent<T>(id);
+        if (!current) return;
+        bool differs = false;
+        for (size_t i = 0; i < defs.size() && !differs; ++i)
+            differs = has[i] && defs[i].get(*current) != static_cast<float>(in[i]);
+        if (!differs) return;
+        T& c = reg.GetComponent<T>(id);
+        for (size_t i = 0; i < defs.size(); ++i)
+            if (has[i]) defs[i].set(c, static_cast<float>(in[i]));
+    };
+    b.prefab = [defs](ECS::Prefab& prefab, const lua_Number* in, const char* has) {
+        T c{};
+        for (size_t i = 0; i < defs.size(); ++i)
+            if (has[i]) defs[i].set(c, static_cast<float>(in[i]));
+        prefab.Set<T>(c);
+    };
+    return b;
+}
+
+static const std::vector<ComponentBinding>& componentBindings()
+{
+    using namespace ECS;
+    static const std::vector<ComponentBinding> s_bindings = {
+        bindComponent<TransformComponent>("Transform", {
+            {"x", [](const auto& t) { return t.position.x; }, [](auto& t, float v) { t.position.x = v; }},
+            {"y", [](const auto& t) { return t.position.y; }, [](auto& t, float v) { t.position.y = v; }},
+            {"z", [](const auto& t) { return t.position.z; }, [](auto& t, float v) { t.position.z = v; }},
+        }),
+        bindComponent<VelocityComponent>("Velocity", {
+            {"vx", [](const auto& v) { return v.linear.x; }, [](auto& v, float f) { v.linear.x = f; }},
+            {"vy", [](const auto& v) { return v.linear.y; }, [](auto& v, float f) { v.linear.y = f; }},
+            {"vz", [](const auto& v) { return v.linear.z; }, [](auto& v, float f) { v.linear.z = f; }},
+        }),
+        bindComponent<HealthComponent>("Health", {
+            {"hp",    [](const auto& h) { return h.current; }, [](auto& h, float f) { h.current = f; }},
+            {"maxHp", [](const auto& h) { return h.max; },     [](auto& h, float f) { h.max = f; }},
+        }),
+        bindComponent<LifetimeComponent>("Lifetime", {
+            {"life", [](const auto& l) { return l.remaining; }, [](auto& l, float f) { l.remaining = f; }},
+        }),
+    };
+    return s_bindings;
+}
+
+// Binding named `name`; raises a Lua error for unknown names.
+static const ComponentBinding& checkBinding(lua_State* L, const char* name)
+{
+    for (const auto& b : componentBindings())
+        if (std::strcmp(b.name, name) == 0) return b;
+    luaL_error(L, "ecs: unknown component '%s' (Transform, Velocity, Health, Lifetime)", name);
+    return componentBindings().front();     // not reached: luaL_error longjmps
+}
+
+// The query functions below raise Lua errors (a longjmp) from argument
+// checks, metamethods on script tables and the script callbacks they run,
+// so nothing they keep across a Lua call may need a destructor: the parsed
+// component list is fixed-size, and per-call buffers are userdata scratch.
+
+static constexpr size_t MAX_QUERY_COMPONENTS = 8;
+static constexpr size_t MAX_QUERY_FIELDS     = 32;
+
+// A parsed component list: the bindings plus the flattened field layout.
+struct QuerySpec {
+    const ComponentBinding* components[MAX_QUERY_COMPONENTS];
+    const char*             fields[MAX_QUERY_FIELDS];  // every field, in component order
+    size_t                  componentCount = 0;
+    size_t                  fieldCount     = 0;
+    ECS::ComponentMask      mask;
+};
+
+// An uninitialised array of n Ts in a new userdata pushed on the stack; the
+// GC frees it, so it must stay on the stack while in use.
+template<typename T>
+static T* pushScratch(lua_State* L, size_t n)
+{
+    static_assert(std::is_trivially_destructible_v<T>);
+    return static_cast<T*>(lua_newuserdatauv(L, n * sizeof(T), 0));
+}
+
+// Parse arg `idx` — a component name or an array of names — into spec.
+// Raises a Lua error for unknown names; repeated names are listed once.
+static void checkQuerySpec(lua_State* L, int idx, QuerySpec& spec)
+{
+    auto add = [&](const char* name) {
+        const ComponentBinding& b = checkBinding(L, name);
+        if (spec.mask.test(b.type)) return;
+        if (spec.componentCount == MAX_QUERY_COMPONENTS || spec.fieldCount + b.fields.size() > MAX_QUERY_FIELDS)
+            luaL_error(L, "ecs: too many components in one query");
+        spec.components[spec.componentCount++] = &b;
+        for (const char* field : b.fields) spec.fields[spec.fieldCount++] = field;
+        spec.mask.set(b.type);
+    };
+
+    if (lua_type(L, idx) == LUA_TSTRING) {
+        add(lua_tostring(L, idx));
+    } else {
+        luaL_checktype(L, idx, LUA_TTABLE);
+        const lua_Integer n = static_cast<lua_Integer>(lua_rawlen(L, idx));
+        for (lua_Integer i = 1; i <= n; ++i) {
+            lua_rawgeti(L, idx, i);
+            const char* name = lua_tostring(L, -1);
+            if (!name) luaL_error(L, "ecs: component list entry %d is not a string", static_cast<int>(i));
+            add(name);
+            lua_pop(L, 1);
+        }
+    }
+    if (spec.componentCount == 0) luaL_error(L, "ecs: empty component list");
+}
+
+// Every live entity owning all of spec's components, walked from the
+// smallest of their pools, into scratch pushed on the stack (out); returns
+// how many. Collected up front so the Lua side may create / destroy
+// entities while the results are processed.
+static size_t collectMatches(lua_State* L, const QuerySpec& spec, ECS::EntityId*& out)
+{
+    const ECS::IPool* smallest = nullptr;
+    for (size_t c = 0; c < spec.componentCount; ++c) {
+        const ECS::IPool* p = g_registry->PoolById(spec.components[c]->type);
+        if (!p) { smallest = nullptr; break; }
+        if (!smallest || p->Size() < smallest->Size()) smallest = p;
+    }
+    out = pushScratch<ECS::EntityId>(L, smallest ? smallest->Size() : 0);
+    if (!smallest) return 0;
+
+    size_t count = 0;
+    for (const uint32_t idx : smallest->EntityIndices()) {
+        const ECS::EntityId id = g_registry->EntityAt(idx);
+        if ((g_registry->Signature(id) & spec.mask) == spec.mask) out[count++] = id;
+    }
+    return count;
+}
+
+// Read every field of spec for entity id into out (spec.fieldCount values).
+static bool readFields(const QuerySpec& spec, ECS::EntityId id, lua_Number* out)
+{
+    for (size_t c = 0; c < spec.componentCount; ++c) {
+        const ComponentBinding& b = *spec.components[c];
+        if (!b.read(*g_registry, id, out)) return false;
+        out += b.fields.size();
+    }
+    return true;
+}
+
+// Write the fields flagged in `has` back to entity id (skipped if it died
+// or lost a component meanwhile).
+static void writeFields(const QuerySpec& spec, ECS::EntityId id, const lua_Number* in, const char* has)
+{
+    if (!g_registry->IsAlive(id) || (g_registry->Signature(id) & spec.mask) != spec.mask) return;
+    for (size_t c = 0; c < spec.componentCount; ++c) {
+        const ComponentBinding& b = *spec.components[c];
+        b.write(*g_registry, id, in, has);
+        in  += b.fields.size();
+        has += b.fields.size();
+    }
+}
+
+// Batch table at `tbl`: { n = count, id = {...}, <field> = {...}, ... }.
+// Reuses existing arrays; only [1..n] of each array is meaningful.
+static void fillBatch(lua_State* L, int tbl, const QuerySpec& spec,
+                      const ECS::EntityId* ids, size_t count, const lua_Number* values)
+{
+    const size_t nf = spec.fieldCount;
+    lua_pushinteger(L, static_cast<lua_Integer>(count));
+    lua_setfield(L, tbl, "n");
+
+    auto column = [&](const char* key) {
+        if (lua_getfield(L, tbl, key) != LUA_TTABLE) {
+            lua_pop(L, 1);
+            lua_createtable(L, static_cast<int>(count), 0);
+            lua_pushvalue(L, -1);
+            lua_setfield(L, tbl, key);
+        }
+    };
+
+    column("id");
+    for (size_t i = 0; i < count; ++i) {
+        lua_pushinteger(L, static_cast<lua_Integer>(ids[i]));
+        lua_rawseti(L, -2, static_cast<lua_Integer>(i + 1));
+    }
+    lua_pop(L, 1);
+
+    for (size_t f = 0; f < nf; ++f) {
+        column(spec.fields[f]);
+        for (size_t i = 0; i < count; ++i) {
+            lua_pushnumber(L, values[i * nf + f]);
+            lua_rawseti(L, -2, static_cast<lua_Integer>(i + 1));
+        }
+        lua_pop(L, 1);
+    }
+}
+
+// Read fields [1..count] of the batch table at `tbl` back into values;
+// has[i * nf + f] is false where the script left a non-number.
+static void readBatch(lua_State* L, int tbl, const QuerySpec& spec, size_t count,
+                      lua_Number* values, char* has)
+{
+    const size_t nf = spec.fieldCount;
+    for (size_t f = 0; f < nf; ++f) {
+        const bool isTable = lua_getfield(L, tbl, spec.fields[f]) == LUA_TTABLE;
+        for (size_t i = 0; i < count; ++i) {
+            bool ok = false;
+            if (isTable) {
+                lua_rawgeti(L, -1, static_cast<lua_Integer>(i + 1));
+                int isNum = 0;
+                const lua_Number v = lua_tonumberx(L, -1, &isNum);
+                if (isNum) { values[i * nf + f] = v; ok = true; }
+                lua_pop(L, 1);
+            }
+            has[i * nf + f] = ok ? 1 : 0;
+        }
+        lua_pop(L, 1);
+    }
+}
+
+// ecs.query(components [, fn [, batchSize]])
+//
+// Without fn: returns one batch table holding every match.
+// With fn: calls fn(batch) for consecutive batches of up to batchSize
+// (default 256) entities and writes each batch's fields back when fn returns.
+static void queryBatches(lua_State* L, const QuerySpec& spec, size_t batchSize)
+{
+    ECS::EntityId* ids;
+    const size_t count = collectMatches(L, spec, ids);
+    const size_t nf    = spec.fieldCount;
+    batchSize = std::min(batchSize, count);
+
+    auto* batchIds = pushScratch<ECS::EntityId>(L, batchSize);
+    auto* values   = pushScratch<lua_Number>(L, batchSize * nf);
+    auto* has      = pushScratch<char>(L, batchSize * nf);
+
+    lua_newtable(L);                        // reused batch table
+    const int tbl = lua_gettop(L);
+
+    for (size_t begin = 0; begin < count; begin += batchSize) {
+        const size_t end = std::min(count, begin + batchSize);
+        size_t n = 0;
+        for (size_t i = begin; i < end; ++i) {
+            if (!g_registry || !g_registry->IsAlive(ids[i])) continue;
+            if (readFields(spec, ids[i], values + n * nf)) batchIds[n++] = ids[i];
+        }
+        if (n == 0) continue;
+
+        fillBatch(L, tbl, spec, batchIds, n, values);
+        lua_pushvalue(L, 2);
+        lua_pushvalue(L, tbl);
+        lua_call(L, 1, 0);
+        if (!g_registry) break;             // scene unloaded from inside fn
+
+        readBatch(L, tbl, spec, n, values, has);
+        for (size_t i = 0; i < n; ++i)
+            writeFields(spec, batchIds[i], values + i * nf, has + i * nf);
+    }
+}
+
+static int l_query(lua_State* L)
+{
+    QuerySpec spec;
+    checkQuerySpec(L, 1, spec);
+
+    if (lua_isnoneornil(L, 2)) {
+        // Array-returning form: one batch with every match.
+        lua_newtable(L);
+        const int tbl = lua_gettop(L);
+        if (!g_registry) { lua_pushinteger(L, 0); lua_setfield(L, tbl, "n"); return 1; }
+        ECS::EntityId* ids;
+        const size_t count  = collectMatches(L, spec, ids);
+        auto*        values = pushScratch<lua_Number>(L, count * spec.fieldCount);
+        for (size_t i = 0; i < count; ++i)
+            readFields(spec, ids[i], values + i * spec.fieldCount);
+        fillBatch(L, tbl, spec, ids, count, values);
+        lua_settop(L, tbl);
+        return 1;
+    }
+
+    luaL_checktype(L, 2, LUA_TFUNCTION);
+    const lua_Integer batch = luaL_optinteger(L, 3, 256);
+    luaL_argcheck(L, batch > 0, 3, "batch size must be positive");
+    if (!registryReady(L)) return 0;
+    queryBatches(L, spec, static_cast<size_t>(batch));
+    return 0;
+}
+
+// ecs.update(components, batch)
+//
+// Write a batch table (as returned by ecs.query) back: for each i in
+// [1..batch.n], the fields of batch.id[i]. Entities that died or lost a
+// component are skipped, as are fields left nil.
+static void updateFromBatch(lua_State* L, const QuerySpec& spec)
+{
+    const size_t nf = spec.fieldCount;
+    lua_getfield(L, 2, "n");
+    const lua_Integer n = lua_isinteger(L, -1) ? lua_tointeger(L, -1) : 0;
+    lua_pop(L, 1);
+    if (n <= 0) return;
+    if (lua_getfield(L, 2, "id") != LUA_TTABLE) return;
+    const int idTbl = lua_gettop(L);
+
+    // Rows past the end of batch.id have no entity to write to.
+    const size_t count = std::min(static_cast<size_t>(n), static_cast<size_t>(lua_rawlen(L, idTbl)));
+    auto* ids = pushScratch<ECS::EntityId>(L, count);
+    for (size_t i = 0; i < count; ++i) {
+        lua_rawgeti(L, idTbl, static_cast<lua_Integer>(i + 1));
+        ids[i] = lua_isinteger(L, -1) ? static_cast<ECS::EntityId>(lua_tointeger(L, -1)) : ECS::INVALID_ENTITY;
+        lua_pop(L, 1);
+    }
+
+    auto* values = pushScratch<lua_Number>(L, count * nf);
+    auto* has    = pushScratch<char>(L, count * nf);
+    readBatch(L, 2, spec, count, values, has);
+    for (size_t i = 0; i < count; ++i)
+        writeFields(spec, ids[i], values + i * nf, has + i * nf);
+}
+
+static int l_update(lua_State* L)
+{
+    QuerySpec spec;
+    checkQuerySpec(L, 1, spec);
+    luaL_checktype(L, 2, LUA_TTABLE);
+    if (!registryReady(L)) return 0;
+    updateFromBatch(L, spec);
+    return 0;
+}
+
+// ecs.each(components, fn)
+//
+// Calls fn(id, <fields...>) per matching entity, fields flattened in
+// component order. Values fn returns are written back to the leading
+// fields (return nothing to leave the entity unchanged).
+static void eachEntity(lua_State* L, const QuerySpec& spec)
+{
+    ECS::EntityId* ids;
+    const size_t count  = collectMatches(L, spec, ids);
+    const size_t nf     = spec.fieldCount;
+    auto*        values = pushScratch<lua_Number>(L, nf);
+    auto*        has    = pushScratch<char>(L, nf);
+    luaL_checkstack(L, static_cast<int>(nf) + 2, "ecs.each");
+
+    for (size_t i = 0; i < count; ++i) {
+        const ECS::EntityId id = ids[i];
+        if (!g_registry) break;             // scene unloaded from inside fn
+        if (!g_registry->IsAlive(id) || !readFields(spec, id, values)) continue;
+
+        const int base = lua_gettop(L);
+        lua_pushvalue(L, 2);
+        lua_pushinteger(L, static_cast<lua_Integer>(id));
+        for (size_t f = 0; f < nf; ++f) lua_pushnumber(L, values[f]);
+        lua_call(L, static_cast<int>(nf + 1), LUA_MULTRET);
+
+        const int results = std::min(lua_gettop(L) - base, static_cast<int>(nf));
+        if (results > 0 && g_registry) {
+            for (size_t f = 0; f < nf; ++f) {
+                int isNum = 0;
+                const lua_Number v = static_cast<int>(f) < results
+                    ? lua_tonumberx(L, base + 1 + static_cast<int>(f), &isNum) : 0.0;
+                values[f] = v;
+                has[f]    = isNum ? 1 : 0;
+            }
+            writeFields(spec, id, values, has);
+        }
+        lua_settop(L, base);
+    }
+}
+
+static int l_each(lua_State* L)
+{
+    QuerySpec spec;
+    checkQuerySpec(L, 1, spec);
+    luaL_checktype(L, 2, LUA_TFUNCTION);
+    if (!registryReady(L)) return 0;
+    eachEntity(L, spec);
+    return 0;
+}
+
+// ── Component references ─────────────────────────────────────────────────────
+// ecs.ref(id, "Transform") returns a small userdata proxy whose fields read
+// and write the component in place:
+//
+//   local t = ecs.ref(e, "Transform")
+//   t.x = t.x + 1
+//
+// No tables and no multiple returns per access. The proxy stores the
+// EntityId (index + generation) and the registry it came from, NOT a pointer
+// into the pool — dense slots move on swap-remove — and every access
+// re-checks both: once the entity is destroyed, its slot reused, the
+// component removed or the scene changed, reads return nil and writes are
+// ignored.
+
+static constexpr const char* COMPONENT_REF_MT = "Hotones.ecs.ComponentRef";
+static constexpr size_t      MAX_REF_FIELDS   = 8;
+
+struct ComponentRef {
+    ECS::Registry*          registry;
+    ECS::EntityId           id;
+    const ComponentBinding* binding;
+};
+
+// True if the proxy still refers to a live component of the active registry.
+static bool refValid(const ComponentRef& ref)
+{
+    return g_registry && ref.registry == g_registry && g_registry->IsAlive(ref.id)
+        && g_registry->Signature(ref.id).test(ref.binding->type);
+}
+
+static int refField(const ComponentBinding& b, const char* name)
+{
+    for (size_t i = 0; i < b.fields.size(); ++i)
+        if (std::strcmp(b.fields[i], name) == 0) return static_cast<int>(i);
+    return -1;
+}
+
+// ecs.ref(id, component) → proxy, or nil if the entity does not own it.
+static int l_ref(lua_State* L)
+{
+    const auto id = static_cast<ECS::EntityId>(luaL_checkinteger(L, 1));
+    const ComponentBinding& b = checkBinding(L, luaL_checkstring(L, 2));
+    assert(b.fields.size() <= MAX_REF_FIELDS);
+    if (!registryReady(L)) { lua_pushnil(L); return 1; }
+    if (!g_registry->IsAlive(id) || !g_registry->Signature(id).test(b.type)) { lua_pushnil(L); return 1; }
+
+    auto* ref = static_cast<ComponentRef*>(lua_newuserdatauv(L, sizeof(ComponentRef), 0));
+    *ref = ComponentRef{ g_registry, id, &b };
+    luaL_setmetatable(L, COMPONENT_REF_MT);
+    return 1;
+}
+
+// ref.<field> → number (nil if stale); ref.id → entity id; ref.valid → bool.
+static int ref_index(lua_State* L)
+{
+    const auto& ref = *static_cast<const ComponentRef*>(luaL_checkudata(L, 1, COMPONENT_REF_MT));
+    const char* key = luaL_checkstring(L, 2);
+    if (std::strcmp(key, "id") == 0)    { lua_pushinteger(L, static_cast<lua_Integer>(ref.id)); return 1; }
+    if (std::strcmp(key, "valid") == 0) { lua_pushboolean(L, refValid(ref)); return 1; }
+
+    const int field = refField(*ref.binding, key);
+    if (field < 0) return luaL_error(L, "ecs: %s has no field '%s'", ref.binding->name, key);
+
+    lua_Number values[MAX_REF_FIELDS];
+    if (!refValid(ref) || !ref.binding->read(readRegistry(), ref.id, values)) { lua_pushnil(L); return 1; }
+    lua_pushnumber(L, values[field]);
+    return 1;
+}
+
+// ref.<field> = number; ignored if the proxy is stale.
+static int ref_newindex(lua_State* L)
+{
+    const auto& ref = *static_cast<const ComponentRef*>(luaL_checkudata(L, 1, COMPONENT_REF_MT));
+    const char* key = luaL_checkstring(L, 2);
+    const int field = refField(*ref.binding, key);
+    if (field < 0) return luaL_error(L, "ecs: %s has no field '%s'", ref.binding->name, key);
+    const lua_Number v = luaL_checknumber(L, 3);
+    if (!refValid(ref)) return 0;
+
+    lua_Number values[MAX_REF_FIELDS] = {};
+    char       has[MAX_REF_FIELDS]    = {};
+    values[field] = v;
+    has[field]    = 1;
+    ref.binding->write(*g_registry, ref.id, values, has);
+    return 0;
+}
+
+static int ref_tostring(lua_State* L)
+{
+    const auto& ref = *static_cast<const ComponentRef*>(luaL_checkudata(L, 1, COMPONENT_REF_MT));
+    lua_pushfstring(L, "ecs.ref(%I, %s)%s", static_cast<lua_Integer>(ref.id), ref.binding->name,
+                    refValid(ref) ? "" : " [stale]");
+    return 1;
+}
+
+static int ref_eq(lua_State* L)
+{
+    const auto& a = *static_cast<const ComponentRef*>(luaL_checkudata(L, 1, COMPONENT_REF_MT));
+    const auto& b = *static_cast<const ComponentRef*>(luaL_checkudata(L, 2, COMPONENT_REF_MT));
+    lua_pushboolean(L, a.registry == b.registry && a.id == b.id && a.binding == b.binding);
+    return 1;
+}
+
+// ── Prefabs ──────────────────────────────────────────────────────────────────
+// A prefab definition is a table keyed by component name, each holding the
+// same fields as the bulk-query bindings, plus an optional Tag string:
+//
+//   local bullet = ecs.prefab({
+//       Transform = { x = 0, y = 1, z = 0 },
+//       Velocity  = { vz = 50 },
+//       Lifetime  = { life = 3 },
+//       Tag       = "Bullet",
+//   })
+//   local ids = ecs.spawnPrefab(bullet, 500)
+//
+// spawnPrefab goes through Registry::Instantiate: one reserve and one
+// append pass per pool instead of 500 × (create + add per component).
+
+static constexpr const char* PREFAB_MT = "Hotones.ecs.Prefab";
+
+// Build a Prefab from the definition table at idx. Raises a Lua error for
+// unknown component names.
+static void checkPrefabDef(lua_State* L, int idx, ECS::Prefab& prefab)
+{
+    luaL_checktype(L, idx, LUA_TTABLE);
+    idx = lua_absindex(L, idx);
+
+    lua_pushnil(L);
+    while (lua_next(L, idx) != 0) {
+        // key at -2, value at -1
+        const char* name = lua_type(L, -2) == LUA_TSTRING ? lua_tostring(L, -2) : nullptr;
+        if (!name) luaL_error(L, "ecs.prefab: keys must be component names");
+
+        if (std::strcmp(name, "Tag") == 0) {
+            prefab.Set(ECS::TagComponent{ luaL_checkstring(L, -1) });
+            lua_pop(L, 1);
+            continue;
+        }
+
+        const ComponentBinding& b = checkBinding(L, name);
+        assert(b.fields.size() <= MAX_REF_FIELDS);
+        if (!lua_istable(L, -1)) luaL_error(L, "ecs.prefab: %s must be a table of fields", name);
+
+        lua_Number values[MAX_REF_FIELDS] = {};
+        char       has[MAX_REF_FIELDS]    = {};
+        for (size_t f = 0; f < b.fields.size(); ++f) {
+            lua_getfield(L, -1, b.fields[f]);
+            int isNum = 0;
+            values[f] = lua_tonumberx(L, -1, &isNum);
+            has[f]    = isNum ? 1 : 0;
+            lua_pop(L, 1);
+        }
+        // Health = { maxHp = n } starts full, as with ecs.addHealth.
+        if (std::strcmp(name, "Health") == 0 && !has[0] && has[1]) {
+            values[0] = values[1];
+            has[0]    = 1;
+        }
+        b.prefab(prefab, values, has);
+        lua_pop(L, 1);
+    }
+}
+
+// ecs.prefab(def) → prefab
+static int l_prefab(lua_State* L)
+{
+    auto* prefab = static_cast<ECS::Prefab*>(lua_newuserdatauv(L, sizeof(ECS::Prefab), 0));
+    new (prefab) ECS::Prefab();
+    luaL_setmetatable(L, PREFAB_MT);    // __gc now owns it, even if def is invalid
+    checkPrefabDef(L, 1, *prefab);
+    return 1;
+}
+
+static int prefab_gc(lua_State* L)
+{
+    static_cast<ECS::Prefab*>(luaL_checkudata(L, 1, PREFAB_MT))->~Prefab();
+    return 0;
+}
+
+// Create count entities from prefab; pushes the array of their ids.
+static void spawnPrefab(lua_State* L, const ECS::Prefab& prefab, size_t count)
+{
+    auto* ids = pushScratch<ECS::EntityId>(L, count);
+    g_registry->Instantiate(prefab, std::span<ECS::EntityId>(ids, count));
+    lua_createtable(L, static_cast<int>(count), 0);
+    for (size_t i = 0; i < count; ++i) {
+        lua_pushinteger(L, static_cast<lua_Integer>(ids[i]));
+        lua_rawseti(L, -2, static_cast<lua_Integer>(i + 1));
+    }
+    lua_remove(L, -2);                      // the scratch
+}
+
+// ecs.spawnPrefab(prefab | def [, count]) → { id, ... }
+static int l_spawnPrefab(lua_State* L)
+{
+    constexpr lua_Integer MAX_ENTITIES = static_cast<lua_Integer>(ECS::INDEX_MASK) + 1;
+    const lua_Integer count = luaL_optinteger(L, 2, 1);
+    luaL_argcheck(L, count >= 0 && count <= MAX_ENTITIES, 2, "count out of range");
+    if (!registryReady(L)) { lua_newtable(L); return 1; }
+    luaL_argcheck(L, count <= MAX_ENTITIES - static_cast<lua_Integer>(g_registry->EntityCount()), 2,
+                  "not enough free entity ids");
+
+    if (const auto* prefab = static_cast<const ECS::Prefab*>(luaL_testudata(L, 1, PREFAB_MT))) {
+        spawnPrefab(L, *prefab, static_cast<size_t>(count));
+        return 1;
+    }
+
+    // Inline definition: build a throwaway prefab (as a userdata, so it is
+    // released by the GC if the definition raises an error).
+    lua_pushcfunction(L, l_prefab);
+    lua_pushvalue(L, 1);
+    lua_call(L, 1, 1);
+    spawnPrefab(L, *static_cast<const ECS::Prefab*>(lua_touserdata(L, -1)), static_cast<size_t>(count));
+    return 1;
+}
+
 // ── Registration ─────────────────────────────────────────────────────────────
 
 void registerECS(lua_State* L)
@@ -337,6 +1043,7 @@ void registerECS(lua_State* L)
         {"create",          l_create},
         {"destroy",         l_destroy},
         {"isAlive",         l_isAlive},
+        {"isRestored",      l_isRestored},
         // Transform
         {"setPos",          l_setPos},
         {"getPos",          l_getPos},
@@ -346,6 +1053,8 @@ void registerECS(lua_State* L)
         // Tag
         {"setTag",          l_setTag},
         {"getTag",          l_getTag},
+        {"findByTag",       l_findByTag},
+        {"findAllByTag",    l_findAllByTag},
         // Health
         {"addHealth",       l_addHealth},
         {"getHealth",       l_getHealth},
@@ -360,8 +1069,40 @@ void registerECS(lua_State* L)
         {"hasPlayer",       l_hasPlayer},
         {"removePlayer",    l_removePlayer},
         {"setPlayerBhop",   l_setPlayerBhop},
+        // Hierarchy
+        {"setParent",       l_setParent},
+        {"getParent",       l_getParent},
+        {"getWorldPos",     l_getWorldPos},
+        // Bulk queries
+        {"query",           l_query},
+        {"each",            l_each},
+        {"update",          l_update},
+        // Component references
+        {"ref",             l_ref},
+        // Prefabs
+        {"prefab",          l_prefab},
+        {"spawnPrefab",     l_spawnPrefab},
+        {nullptr, nullptr}
+    };
+
+    static const luaL_Reg refMeta[] = {
+        {"__index",         ref_index},
+        {"__newindex",      ref_newindex},
+        {"__tostring",      ref_tostring},
+        {"__eq",            ref_eq},
+        {nullptr, nullptr}
+    };
+    luaL_newmetatable(L, COMPONENT_REF_MT);
+    luaL_setfuncs(L, refMeta, 0);
+    lua_pop(L, 1);
+
+    static const luaL_Reg prefabMeta[] = {
+        {"__gc",            prefab_gc},
         {nullptr, nullptr}
     };
+    luaL_newmetatable(L, PREFAB_MT);
+    luaL_setfuncs(L, prefabMeta, 0);
+    lua_pop(L, 1);
 
     luaL_newlib(L, funcs);
     lua_setglobal(L, "ecs");
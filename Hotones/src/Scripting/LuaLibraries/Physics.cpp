@@ -86,10 +86,117 @@ static int l_sweepSphere(lua_State* L) {
     return 1;
 }
 
+// physics.raycastMany(handle, rays [, maxDist [, out]]) → out, hitCount
+//
+// rays is a flat array of ray origins and directions:
+//   { ox1, oy1, oz1, dx1, dy1, dz1,  ox2, oy2, oz2, dx2, dy2, dz2, ... }
+// All rays are answered in one RaycastBatch call. The results come back as
+// parallel arrays (like an ecs.query batch): out.n, out.hit[i] and, for
+// hits, out.x/y/z[i], out.nx/ny/nz[i], out.t[i]. Pass the previous out
+// table back in to reuse it instead of allocating a new one.
+static int l_raycastMany(lua_State* L) {
+    int   handle  = (int)luaL_checkinteger(L, 1);
+    luaL_checktype(L, 2, LUA_TTABLE);
+    float maxDist = (float)luaL_optnumber(L, 3, 1000.0);
+
+    const lua_Integer len = (lua_Integer)lua_rawlen(L, 2);
+    if (len % 6 != 0)
+        return luaL_argerror(L, 2, "expected 6 numbers (origin, direction) per ray");
+    const int count = (int)(len / 6);
+
+    // Scratch arrays live in Lua userdata rather than std::vector: a bad
+    // element raises a Lua error, and that longjmp would skip destructors.
+    lua_settop(L, 4);
+    auto* rays = static_cast<Hotones::Physics::RayQuery*>(
+        lua_newuserdatauv(L, sizeof(Hotones::Physics::RayQuery) * (size_t)count, 0));
+    auto* hits = static_cast<Hotones::Physics::QueryHit*>(
+        lua_newuserdatauv(L, sizeof(Hotones::Physics::QueryHit) * (size_t)count, 0));
+    for (int r = 0; r < count; ++r) {
+        float v[6];
+        for (int k = 0; k < 6; ++k) {
+            const lua_Integer i = (lua_Integer)r * 6 + k + 1;
+            lua_rawgeti(L, 2, i);
+            int isNum = 0;
+            v[k] = (float)lua_tonumberx(L, -1, &isNum);
+            lua_pop(L, 1);
+            if (!isNum) return luaL_argerror(L, 2, lua_pushfstring(L, "number expected at index %I", i));
+        }
+        rays[r] = { { v[0], v[1], v[2] }, { v[3], v[4], v[5] }, maxDist };
+        hits[r] = {};
+    }
+
+    const int hitCount = Hotones::Physics::RaycastBatch(handle, rays, count, hits);
+
+    int out = 4;
+    if (!lua_istable(L, out)) { lua_createtable(L, 0, 9); out = lua_gettop(L); }
+
+    lua_pushinteger(L, count);
+    lua_setfield(L, out, "n");
+    auto column = [&](const char* name, auto value) {
+        lua_getfield(L, out, name);
+        if (!lua_istable(L, -1)) {
+            lua_pop(L, 1);
+            lua_createtable(L, count, 0);
+            lua_pushvalue(L, -1);
+            lua_setfield(L, out, name);
+        }
+        for (int r = 0; r < count; ++r) {
+            value(hits[r]);
+            lua_rawseti(L, -2, r + 1);
+        }
+        // Drop entries left over from a larger previous batch
+        for (lua_Integer r = count + 1; lua_rawgeti(L, -1, r) != LUA_TNIL; ++r) {
+            lua_pop(L, 1);
+            lua_pushnil(L);
+            lua_rawseti(L, -2, r);
+        }
+        lua_pop(L, 2);
+    };
+    column("hit", [L](const Hotones::Physics::QueryHit& h) { lua_pushboolean(L, h.hit ? 1 : 0); });
+    column("x",   [L](const Hotones::Physics::QueryHit& h) { lua_pushnumber(L, h.pos.x); });
+    column("y",   [L](const Hotones::Physics::QueryHit& h) { lua_pushnumber(L, h.pos.y); });
+    column("z",   [L](const Hotones::Physics::QueryHit& h) { lua_pushnumber(L, h.pos.z); });
+    column("nx",  [L](const Hotones::Physics::QueryHit& h) { lua_pushnumber(L, h.normal.x); });
+    column("ny",  [L](const Hotones::Physics::QueryHit& h) { lua_pushnumber(L, h.normal.y); });
+    column("nz",  [L](const Hotones::Physics::QueryHit& h) { lua_pushnumber(L, h.normal.z); });
+    column("t",   [L](const Hotones::Physics::QueryHit& h) { lua_pushnumber(L, h.t); });
+
+    lua_pushvalue(L, out);
+    lua_pushinteger(L, hitCount);
+    return 2;
+}
+
+// physics.isMeshReady(handle) → boolean
+//
+// True once the mesh's BVH has been built; queries against it miss until then.
+static int l_isMeshReady(lua_State* L) {
+    int handle = (int)luaL_checkinteger(L, 1);
+    lua_pushboolean(L, Hotones::Physics::IsMeshReady(handle) ? 1 : 0);
+    return 1;
+}
+
+// physics.pendingBuilds() → integer
+static int l_pendingBuilds(lua_State* L) {
+    lua_pushinteger(L, Hotones::Physics::PendingBuildCount());
+    return 1;
+}
+
+// physics.waitForBuilds()
+//
+// Block until every queued mesh build has finished.
+static int l_waitForBuilds(lua_State* /*L*/) {
+    Hotones::Physics::WaitForPendingBuilds();
+    return 0;
+}
+
 void registerPhysics(lua_State* L) {
     static const luaL_Reg funcs[] = {
-        { "raycast",     l_raycast     },
-        { "sweepSphere", l_sweepSphere },
+        { "raycast",       l_raycast       },
+        { "sweepSphere",   l_sweepSphere   },
+        { "raycastMany",   l_raycastMany   },
+        { "isMeshReady",   l_isMeshReady   },
+        { "pendingBuilds", l_pendingBuilds },
+        { "waitForBuilds", l_waitForBuilds },
         { NULL, NULL }
     };
     luaL_newlib(L, funcs);
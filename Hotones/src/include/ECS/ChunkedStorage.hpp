@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// ChunkedStorage<T> — append-only block array used as a ComponentPool
+// backend in place of std::vector<T>.
+//
+// Elements live in fixed 16 KiB blocks (at least one element per block).
+// Growing past the last block allocates ONE new block — existing elements
+// are never reallocated or moved, so there is no O(n) copy (and no frame
+// hitch) when a pool crosses a power-of-two size.
+//
+// Blocks emptied by pop_back / clear go to a free-list and are reused by
+// the next growth instead of going back to the heap; ShrinkToFit releases
+// them.
+//
+// Addresses are stable across growth. They still change when the pool
+// itself moves an element: swap-remove of another entity, or group
+// packing (SwapDense).
+//
+// Select it for a component type with StorageType (see ComponentPool.hpp):
+//
+//   template<> struct StorageType<ProjectileComponent> {
+//       using Type = ChunkedStorage<ProjectileComponent>;
+//   };
+// ---------------------------------------------------------------------------
+template<typename T>
+class ChunkedStorage {
+public:
+    static constexpr size_t BLOCK_BYTES = 16u * 1024u;
+
+    // Elements per block: the largest power of two that fits BLOCK_BYTES
+    // (so indexing is a shift and a mask), at least 1.
+    static constexpr size_t BLOCK_SIZE = [] {
+        size_t n = 1;
+        while (n * 2 * sizeof(T) <= BLOCK_BYTES) n *= 2;
+        return n;
+    }();
+
+    ChunkedStorage() = default;
+    ~ChunkedStorage() {
+        clear();
+        ShrinkToFit();
+    }
+
+    ChunkedStorage(const ChunkedStorage&)            = delete;
+    ChunkedStorage& operator=(const ChunkedStorage&) = delete;
+
+    ChunkedStorage(ChunkedStorage&& other) noexcept
+        : m_blocks(std::move(other.m_blocks)), m_free(std::move(other.m_free)), m_size(other.m_size) {
+        other.m_blocks.clear();
+        other.m_free.clear();
+        other.m_size = 0;
+    }
+    ChunkedStorage& operator=(ChunkedStorage&& other) noexcept {
+        if (this == &other) return *this;
+        clear();
+        ShrinkToFit();
+        m_blocks = std::move(other.m_blocks);
+        m_free   = std::move(other.m_free);
+        m_size   = other.m_size;
+        other.m_blocks.clear();
+        other.m_free.clear();
+        other.m_size = 0;
+        return *this;
+    }
+
+    [[nodiscard]] size_t size()  const noexcept { return m_size; }
+    [[nodiscard]] bool   empty() const noexcept { return m_size == 0; }
+
+    [[nodiscard]] T& operator[](size_t i) noexcept {
+        assert(i < m_size);
+        return m_blocks[i / BLOCK_SIZE][i % BLOCK_SIZE];
+    }
+    [[nodiscard]] const T& operator[](size_t i) const noexcept {
+        assert(i < m_size);
+        return m_blocks[i / BLOCK_SIZE][i % BLOCK_SIZE];
+    }
+
+    [[nodiscard]] T&       back()       noexcept { return (*this)[m_size - 1]; }
+    [[nodiscard]] const T& back() const noexcept { return (*this)[m_size - 1]; }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (m_size == m_blocks.size() * BLOCK_SIZE) m_blocks.push_back(AcquireBlock());
+        T* slot = m_blocks[m_size / BLOCK_SIZE] + m_size % BLOCK_SIZE;
+        ::new (static_cast<void*>(slot)) T(std::forward<Args>(args)...);
+        ++m_size;
+        return *slot;
+    }
+
+    void pop_back() noexcept {
+        assert(m_size > 0);
+        --m_size;
+        std::destroy_at(m_blocks[m_size / BLOCK_SIZE] + m_size % BLOCK_SIZE);
+        if (m_size % BLOCK_SIZE == 0) {
+            m_free.push_back(m_blocks.back());
+            m_blocks.pop_back();
+        }
+    }
+
+    // Destroy every element; the blocks move to the free-list.
+    void clear() noexcept {
+        while (m_size > 0) pop_back();
+    }
+
+    // Make sure `n` elements fit without allocating during emplace_back.
+    void reserve(size_t n) {
+        const size_t blocks = (n + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        while (m_blocks.size() + m_free.size() < blocks) m_free.push_back(AllocateBlock());
+    }
+
+    // Release the blocks on the free-list back to the heap.
+    void ShrinkToFit() noexcept {
+        for (T* block : m_free) FreeBlock(block);
+        m_free.clear();
+        m_free.shrink_to_fit();
+    }
+
+private:
+    [[nodiscard]] T* AcquireBlock() {
+        if (m_free.empty()) return AllocateBlock();
+        T* block = m_free.back();
+        m_free.pop_back();
+        return block;
+    }
+
+    [[nodiscard]] static T* AllocateBlock() {
+        return static_cast<T*>(::operator new(BLOCK_SIZE * sizeof(T), std::align_val_t{ alignof(T) }));
+    }
+    static void FreeBlock(T* block) noexcept {
+        ::operator delete(block, std::align_val_t{ alignof(T) });
+    }
+
+    std::vector<T*> m_blocks;  // in-use blocks; element i is in m_blocks[i / BLOCK_SIZE]
+    std::vector<T*> m_free;    // empty blocks kept for reuse
+    size_t          m_size = 0;
+};
+
+} // namespace Hotones::ECS
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <ECS/Entity.hpp>
+#include <ECS/Registry.hpp>
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// CommandBuffer — records structural Registry changes for later playback.
+//
+// View / Each iterate the live dense arrays in place, so creating, destroying
+// or adding / removing iterated components from inside the callback is not
+// allowed. Record those changes here instead and Flush() the buffer at a sync
+// point once iteration has finished.
+//
+// Usage
+// -----
+//   CommandBuffer cmd;
+//   reg.Each<LifetimeComponent>([&](EntityId id, LifetimeComponent& lt) {
+//       if ((lt.remaining -= dt) <= 0.0f) cmd.DestroyEntity(id);
+//   });
+//   cmd.Flush(reg);
+//
+// Entities created through the buffer are returned as PendingEntity
+// placeholders; components can be attached to them before they exist, and
+// Created() maps them to real ids after Flush.
+//
+// Commands are played back in record order. Commands that target an entity
+// that is no longer alive at playback time are skipped.
+// ---------------------------------------------------------------------------
+class CommandBuffer {
+public:
+    // Placeholder for an entity that will be created on Flush.
+    struct PendingEntity {
+        uint32_t slot = 0; // index into Created() after Flush
+    };
+
+    // Record a CreateEntity.
+    [[nodiscard]] PendingEntity CreateEntity() {
+        const PendingEntity pending{ m_pendingCount++ };
+        m_commands.push_back({ Kind::Create, pending.slot, true, {} });
+        return pending;
+    }
+
+    // Record a DestroyEntity.
+    void DestroyEntity(EntityId id) {
+        m_commands.push_back({ Kind::Destroy, id, false, {} });
+    }
+    void DestroyEntity(PendingEntity pending) {
+        m_commands.push_back({ Kind::Destroy, pending.slot, true, {} });
+    }
+
+    // Record an AddComponent<T>; args are copied / moved into the buffer.
+    // If the entity already owns a T at playback time the value replaces it.
+    template<typename T, typename... Args>
+    void AddComponent(EntityId id, Args&&... args) {
+        m_commands.push_back({ Kind::Apply, id, false, MakeAdd<T>(std::forward<Args>(args)...) });
+    }
+    template<typename T, typename... Args>
+    void AddComponent(PendingEntity pending, Args&&... args) {
+        m_commands.push_back({ Kind::Apply, pending.slot, true, MakeAdd<T>(std::forward<Args>(args)...) });
+    }
+
+    // Record a RemoveComponent<T>.
+    template<typename T>
+    void RemoveComponent(EntityId id) {
+        m_commands.push_back({ Kind::Apply, id, false,
+            [](Registry& reg, EntityId target) { reg.RemoveComponent<T>(target); } });
+    }
+
+    // Play every recorded command back against reg, then clear the buffer.
+    // Must not be called from inside a View / Each over reg.
+    void Flush(Registry& reg) {
+        m_created.clear();
+        m_created.reserve(m_pendingCount);
+
+        for (auto& cmd : m_commands) {
+            if (cmd.kind == Kind::Create) {
+                m_created.push_back(reg.CreateEntity());
+                continue;
+            }
+            const EntityId target = cmd.pending ? m_created[cmd.target] : cmd.target;
+            if (!reg.IsAlive(target)) continue;
+            if (cmd.kind == Kind::Destroy) reg.DestroyEntity(target);
+            else                           cmd.apply(reg, target);
+        }
+
+        m_commands.clear();
+        m_pendingCount = 0;
+    }
+
+    // Drop every recorded command without applying it.
+    void Clear() {
+        m_commands.clear();
+        m_pendingCount = 0;
+    }
+
+    [[nodiscard]] bool   Empty() const noexcept { return m_commands.empty(); }
+    [[nodiscard]] size_t Size()  const noexcept { return m_commands.size(); }
+
+    // Entities created by the most recent Flush, indexed by PendingEntity::slot.
+    [[nodiscard]] const std::vector<EntityId>& Created() const noexcept { return m_created; }
+
+private:
+    enum class Kind : uint8_t { Create, Destroy, Apply };
+
+    using ApplyFn = std::function<void(Registry&, EntityId)>;
+
+    struct Command {
+        Kind     kind;
+        uint32_t target;  // EntityId, or pending slot when `pending` is set
+        bool     pending;
+        ApplyFn  apply;   // Kind::Apply only
+    };
+
+    template<typename T, typename... Args>
+    static ApplyFn MakeAdd(Args&&... args) {
+        return [value = T{ std::forward<Args>(args)... }](Registry& reg, EntityId target) {
+            if (auto* existing = reg.TryGetComponent<T>(target)) *existing = value;
+            else reg.AddComponent<T>(target, value);
+        };
+    }
+
+    std::vector<Command>  m_commands;
+    std::vector<EntityId> m_created;
+    uint32_t              m_pendingCount = 0;
+};
+
+} // namespace Hotones::ECS
@@ -1,13 +1,35 @@
 #pragma once
 
 #include <ECS/Entity.hpp>
+#include <ECS/ChunkedStorage.hpp>
 #include <vector>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <span>
 #include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
 
 namespace Hotones::ECS {
 
+struct IGroup;
+
 // ---------------------------------------------------------------------------
-// IPool — type-erased base for ComponentPool<T>.
+// ComponentEvents — construct / destroy log of one component type.
+//
+// Owned by the Registry and attached to a pool only while the type has an
+// observer (Registry::OnConstruct / OnDestroy); the Registry appends to it
+// as components come and go and drains it in DispatchEvents.
+// ---------------------------------------------------------------------------
+struct ComponentEvents {
+    std::vector<EntityId> constructed;
+    std::vector<EntityId> destroyed;
+};
+
+// ---------------------------------------------------------------------------
+// IPool — type-erased base for every component pool.
 //
 // Held by the Registry so it can call Remove / Clear on any pool without
 // knowing the concrete component type at compile time.
@@ -27,6 +49,202 @@ struct IPool {
     // Dense array of entity indices that own a component in this pool.
     // Returned by const reference — do NOT hold across mutations.
     virtual const std::vector<uint32_t>& EntityIndices() const = 0;
+
+    // Owning group that keeps this pool sorted (see Registry::Group), or
+    // nullptr. A pool can be owned by at most one group.
+    [[nodiscard]] IGroup* Owner() const noexcept { return m_owner; }
+    void SetOwner(IGroup* group) noexcept { m_owner = group; }
+
+    // Event log to append construct / destroy events to, or nullptr when
+    // nothing observes this component type.
+    [[nodiscard]] ComponentEvents* Events() const noexcept { return m_events; }
+    void SetEvents(ComponentEvents* events) noexcept { m_events = events; }
+
+private:
+    IGroup*          m_owner  = nullptr;
+    ComponentEvents* m_events = nullptr;
+};
+
+// ---------------------------------------------------------------------------
+// ChangeClock — change-tracking tick shared by a Registry and its pools.
+//
+// The Registry owns it and advances it (Registry::AdvanceTick); pools only
+// read it to stamp the slots they add or hand out for writing.
+// ---------------------------------------------------------------------------
+struct ChangeClock {
+    uint32_t tick = 0;
+};
+
+// ---------------------------------------------------------------------------
+// SparseSet — entity index <-> dense slot mapping shared by every pool type.
+//
+// Internals
+// ---------
+//   m_pages   — sparse side, split into SPARSE_PAGE_SIZE-entry pages indexed
+//               by entity index; stores the dense position or EMPTY. Pages
+//               are allocated the first time an entity in their range gets
+//               the component; unallocated pages point at one shared,
+//               read-only all-EMPTY page, so lookups never branch on it.
+//   m_dense   — packed array of entity indices (parallel to the pool's data).
+//   m_added   — per dense slot: tick at which the component was added.
+//   m_changed — per dense slot: tick at which it was last handed out for
+//               writing (mutable Get, non-const View / Each, or added).
+//
+// Derived pools keep their component data parallel to m_dense and mirror
+// every slot move made here (Insert appends, Erase swaps with the last slot,
+// SwapSlots exchanges two slots).
+// ---------------------------------------------------------------------------
+class SparseSet : public IPool {
+public:
+    [[nodiscard]] size_t Size() const override { return m_dense.size(); }
+
+    [[nodiscard]] const std::vector<uint32_t>& EntityIndices() const override {
+        return m_dense;
+    }
+
+    [[nodiscard]] bool Has(uint32_t entityIdx) const {
+        const size_t page = entityIdx >> SPARSE_PAGE_BITS;
+        return page < m_pages.size() && m_pages[page][entityIdx & SPARSE_PAGE_MASK] != EMPTY;
+    }
+
+    // Dense position of the component owned by entityIdx.
+    // Behaviour is undefined if Has(entityIdx) is false.
+    [[nodiscard]] uint32_t Index(uint32_t entityIdx) const {
+        assert(Has(entityIdx) && "SparseSet::Index — entity does not own this component");
+        return Sparse(entityIdx);
+    }
+
+    // ---- Change tracking ------------------------------------------------
+
+    // Tick at which the component in dense slot `slot` was added / last
+    // marked changed.
+    [[nodiscard]] uint32_t AddedTick  (size_t slot) const { return m_added  [slot]; }
+    [[nodiscard]] uint32_t ChangedTick(size_t slot) const { return m_changed[slot]; }
+
+    // Stamp dense slot(s) as changed at the current tick.
+    void MarkChanged(size_t slot) noexcept { m_changed[slot] = m_clock->tick; }
+    void MarkChanged(size_t begin, size_t end) noexcept {
+        std::fill(m_changed.begin() + static_cast<std::ptrdiff_t>(begin),
+                  m_changed.begin() + static_cast<std::ptrdiff_t>(end), m_clock->tick);
+    }
+
+    // Make room for n slots in total without reallocating the dense side.
+    void Reserve(size_t n) {
+        m_dense  .reserve(n);
+        m_added  .reserve(n);
+        m_changed.reserve(n);
+    }
+
+    // Tick source for the stamps (set by the Registry that owns the pool).
+    void SetClock(const ChangeClock* clock) noexcept { m_clock = clock ? clock : &DetachedClock(); }
+
+protected:
+    static constexpr uint32_t EMPTY = ~0u;
+
+    // Append entityIdx to the dense array; returns its new slot.
+    uint32_t Insert(uint32_t entityIdx) {
+        AssurePage(entityIdx >> SPARSE_PAGE_BITS);
+
+        const uint32_t slot = static_cast<uint32_t>(m_dense.size());
+        Sparse(entityIdx) = slot;
+        m_dense  .push_back(entityIdx);
+        m_added  .push_back(m_clock->tick);
+        m_changed.push_back(m_clock->tick);
+        return slot;
+    }
+
+    // Remove entityIdx by moving the last slot into its place.
+    // The derived pool must have mirrored that move on its data already.
+    void Erase(uint32_t entityIdx) {
+        const uint32_t slot = Sparse(entityIdx);
+        const uint32_t last = static_cast<uint32_t>(m_dense.size()) - 1u;
+
+        if (slot != last) {
+            const uint32_t lastEntityIdx = m_dense[last];
+            m_dense[slot]                = lastEntityIdx;
+            Sparse(lastEntityIdx)        = slot;
+            m_added[slot]                = m_added[last];
+            m_changed[slot]              = m_changed[last];
+        }
+
+        m_dense  .pop_back();
+        m_added  .pop_back();
+        m_changed.pop_back();
+        Sparse(entityIdx) = EMPTY;
+    }
+
+    // Exchange the entities in two dense slots.
+    void SwapSlots(uint32_t a, uint32_t b) {
+        std::swap(m_dense  [a], m_dense  [b]);
+        std::swap(m_added  [a], m_added  [b]);
+        std::swap(m_changed[a], m_changed[b]);
+        Sparse(m_dense[a]) = a;
+        Sparse(m_dense[b]) = b;
+    }
+
+    void ClearIndices() {
+        m_pages  .clear();
+        m_owned  .clear();
+        m_dense  .clear();
+        m_added  .clear();
+        m_changed.clear();
+    }
+
+private:
+    static constexpr uint32_t SPARSE_PAGE_BITS = 10u;
+    static constexpr uint32_t SPARSE_PAGE_SIZE = 1u << SPARSE_PAGE_BITS; // 4 KiB per page
+    static constexpr uint32_t SPARSE_PAGE_MASK = SPARSE_PAGE_SIZE - 1u;
+
+    using Page = std::array<uint32_t, SPARSE_PAGE_SIZE>;
+
+    // Shared page every unallocated page slot points at. Never written:
+    // AssurePage swaps in an owned page before any store.
+    static Page& EmptyPage() noexcept {
+        static Page s_empty = [] { Page p; p.fill(EMPTY); return p; }();
+        return s_empty;
+    }
+
+    // Make sure page `page` is an owned (writable) page.
+    void AssurePage(size_t page) {
+        if (page >= m_pages.size()) m_pages.resize(page + 1, EmptyPage().data());
+        if (m_pages[page] != EmptyPage().data()) return;
+        auto owned = std::make_unique<Page>(EmptyPage());
+        m_pages[page] = owned->data();
+        m_owned.push_back(std::move(owned));
+    }
+
+    // Sparse entry of entityIdx; its page must be allocated for writes.
+    [[nodiscard]] uint32_t& Sparse(uint32_t entityIdx) noexcept {
+        return m_pages[entityIdx >> SPARSE_PAGE_BITS][entityIdx & SPARSE_PAGE_MASK];
+    }
+    [[nodiscard]] uint32_t Sparse(uint32_t entityIdx) const noexcept {
+        return m_pages[entityIdx >> SPARSE_PAGE_BITS][entityIdx & SPARSE_PAGE_MASK];
+    }
+
+    // Clock of pools that do not belong to a Registry; stays at tick 0.
+    static const ChangeClock& DetachedClock() noexcept {
+        static const ChangeClock s_clock;
+        return s_clock;
+    }
+
+    std::vector<uint32_t*>             m_pages;   // page table; see class comment
+    std::vector<std::unique_ptr<Page>> m_owned;   // storage of the allocated pages
+    std::vector<uint32_t>              m_dense;   // dense[i] → entityIdx
+    std::vector<uint32_t>              m_added;   // added[i]   → tick component i was added
+    std::vector<uint32_t>              m_changed; // changed[i] → tick component i last changed
+    const ChangeClock*                 m_clock = &DetachedClock();
+};
+
+// ---------------------------------------------------------------------------
+// StorageType<T> — container ComponentPool<T> keeps its packed T array in.
+//
+// Defaults to std::vector<T> (contiguous, fastest to iterate). Specialise it
+// to ChunkedStorage<T> for types that are spawned in large bursts: growth
+// then allocates one block instead of reallocating and moving every T.
+// ---------------------------------------------------------------------------
+template<typename T>
+struct StorageType {
+    using Type = std::vector<T>;
 };
 
 // ---------------------------------------------------------------------------
@@ -34,9 +252,9 @@ struct IPool {
 //
 // Internals
 // ---------
-//   m_sparse  — indexed by entity index; stores the dense position or EMPTY.
-//   m_dense   — packed array of entity indices (parallel to m_data).
-//   m_data    — packed array of T (parallel to m_dense).
+//   SparseSet — entity index <-> dense slot mapping.
+//   m_data    — packed array of T (parallel to the dense entity indices),
+//               a StorageType<T>::Type.
 //
 // Complexity
 // ----------
@@ -45,84 +263,111 @@ struct IPool {
 //   Iterate O(n)  over all live components — tight, cache-friendly loop.
 // ---------------------------------------------------------------------------
 template<typename T>
-class ComponentPool : public IPool {
+class ComponentPool : public SparseSet {
 public:
+    using Storage = typename StorageType<T>::Type;
+
     // ---- IPool interface ------------------------------------------------
 
     void Remove(uint32_t entityIdx) override {
         if (!Has(entityIdx)) return;
 
-        const uint32_t denseIdx = m_sparse[entityIdx];
-        const uint32_t last     = static_cast<uint32_t>(m_dense.size()) - 1u;
-
-        if (denseIdx != last) {
-            // Swap the target with the last element so we keep the array packed.
-            const uint32_t lastEntityIdx = m_dense[last];
-            m_dense[denseIdx]            = lastEntityIdx;
-            m_data [denseIdx]            = std::move(m_data[last]);
-            m_sparse[lastEntityIdx]      = denseIdx;
-        }
+        const uint32_t denseIdx = Index(entityIdx);
+        const uint32_t last     = static_cast<uint32_t>(Size()) - 1u;
 
-        m_dense.pop_back();
-        m_data .pop_back();
-        m_sparse[entityIdx] = EMPTY;
+        // Swap the target with the last element so we keep the array packed.
+        if (denseIdx != last) m_data[denseIdx] = std::move(m_data[last]);
+        m_data.pop_back();
+        Erase(entityIdx);
     }
 
     void Clear() override {
-        m_sparse.clear();
-        m_dense .clear();
-        m_data  .clear();
-    }
-
-    [[nodiscard]] size_t Size() const override { return m_dense.size(); }
-
-    [[nodiscard]] const std::vector<uint32_t>& EntityIndices() const override {
-        return m_dense;
+        ClearIndices();
+        m_data.clear();
     }
 
     // ---- Typed interface ------------------------------------------------
 
-    [[nodiscard]] bool Has(uint32_t entityIdx) const {
-        return entityIdx < m_sparse.size() && m_sparse[entityIdx] != EMPTY;
-    }
-
     // Emplace-construct a T from args directly into the pool.
     // Asserts that the entity does not already own a T.
     template<typename... Args>
     T& Emplace(uint32_t entityIdx, Args&&... args) {
-        if (entityIdx >= m_sparse.size())
-            m_sparse.resize(entityIdx + 1, EMPTY);
-
         assert(!Has(entityIdx) && "ComponentPool::Emplace — entity already owns this component");
 
-        const uint32_t denseIdx = static_cast<uint32_t>(m_dense.size());
-        m_sparse[entityIdx]     = denseIdx;
-        m_dense.push_back(entityIdx);
-        m_data .emplace_back(std::forward<Args>(args)...);
+        Insert(entityIdx);
+        m_data.emplace_back(std::forward<Args>(args)...);
         return m_data.back();
     }
 
+    // Give every entity in entityIdx a copy of value, with one reserve up
+    // front. Asserts that none of them already owns a T.
+    void EmplaceN(std::span<const uint32_t> entityIdx, const T& value) {
+        Reserve(Size() + entityIdx.size());
+        for (const uint32_t idx : entityIdx) {
+            assert(!Has(idx) && "ComponentPool::EmplaceN — entity already owns this component");
+            Insert(idx);
+        }
+        if constexpr (std::is_same_v<Storage, std::vector<T>>) {
+            m_data.insert(m_data.end(), entityIdx.size(), value);
+        } else {
+            for (size_t i = 0; i < entityIdx.size(); ++i) m_data.emplace_back(value);
+        }
+    }
+
+    // Make room for n components in total.
+    void Reserve(size_t n) {
+        SparseSet::Reserve(n);
+        m_data.reserve(n);
+    }
+
     // Get a reference to the component owned by entityIdx.
     // Behaviour is undefined if Has(entityIdx) is false.
+    // The mutable overload marks the component changed; use the const one
+    // for reads.
     [[nodiscard]] T& Get(uint32_t entityIdx) {
         assert(Has(entityIdx) && "ComponentPool::Get — entity does not own this component");
-        return m_data[m_sparse[entityIdx]];
+        const uint32_t slot = Index(entityIdx);
+        MarkChanged(slot);
+        return m_data[slot];
     }
     [[nodiscard]] const T& Get(uint32_t entityIdx) const {
         assert(Has(entityIdx) && "ComponentPool::Get — entity does not own this component");
-        return m_data[m_sparse[entityIdx]];
+        return m_data[Index(entityIdx)];
+    }
+
+    // Exchange two dense slots (entity index and component) in place.
+    // Used by owning groups to pack their members at the front of the pool.
+    void SwapDense(uint32_t a, uint32_t b) {
+        if (a == b) return;
+        using std::swap;
+        swap(m_data[a], m_data[b]);
+        SwapSlots(a, b);
     }
 
     // Access the dense component array directly (for raw iteration).
-    [[nodiscard]] std::vector<T>&       Components()       { return m_data; }
-    [[nodiscard]] const std::vector<T>& Components() const { return m_data; }
+    // Writes through it are not change-tracked; call MarkChanged yourself.
+    [[nodiscard]] Storage&       Components()       { return m_data; }
+    [[nodiscard]] const Storage& Components() const { return m_data; }
 
 private:
-    static constexpr uint32_t EMPTY = ~0u;
+    Storage m_data; // data[i] → component for dense[i]
+};
 
-    std::vector<uint32_t> m_sparse; // sparse[entityIdx] → denseIdx or EMPTY
-    std::vector<uint32_t> m_dense;  // dense[i] → entityIdx
-    std::vector<T>        m_data;   // data[i]  → component for dense[i]
+// ---------------------------------------------------------------------------
+// PoolType<T> — selects the pool class the Registry stores T in.
+//
+// Defaults to ComponentPool<T>. Specialise it to give a component type its
+// own storage layout (see KinematicPool.hpp). A replacement pool derives
+// from SparseSet and provides the same typed interface as ComponentPool:
+// Emplace / Get / SwapDense / Components()[i].
+// ---------------------------------------------------------------------------
+template<typename T>
+struct PoolType {
+    using Type = ComponentPool<T>;
 };
 
+// cv-qualifiers are ignored: PoolOf<const T> is PoolOf<T>.
+template<typename T>
+using PoolOf = typename PoolType<std::remove_cv_t<T>>::Type;
+
 } // namespace Hotones::ECS
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// ComponentTypeId — dense integer id for a component type.
+//
+// Ids are handed out by a process-wide family counter the first time a type
+// is used (0, 1, 2, ...), so the Registry can keep its pools in a flat vector
+// indexed by id instead of hashing std::type_index on every access.
+//
+// Ids are stable for the lifetime of the process but depend on first-use
+// order, so they must NOT be persisted or sent over the network.
+// ---------------------------------------------------------------------------
+
+using ComponentTypeId = uint32_t;
+
+// Upper bound on distinct component types per process; sizes ComponentMask.
+// Ids are assigned at run time, so going past it is caught when the first
+// type over the limit is used — in every build, not just debug ones.
+inline constexpr ComponentTypeId MAX_COMPONENT_TYPES = 128u;
+
+// One bit per ComponentTypeId — the set of component types an entity owns.
+using ComponentMask = std::bitset<MAX_COMPONENT_TYPES>;
+
+namespace Detail {
+
+[[nodiscard]] inline ComponentTypeId NextComponentTypeId() noexcept {
+    static std::atomic<ComponentTypeId> s_counter{ 0 };
+    const ComponentTypeId id = s_counter.fetch_add(1u, std::memory_order_relaxed);
+    if (id >= MAX_COMPONENT_TYPES) {
+        // Every ComponentMask would be indexed out of range from here on.
+        std::fprintf(stderr, "ECS: more than %u component types in use — raise MAX_COMPONENT_TYPES\n",
+                     static_cast<unsigned>(MAX_COMPONENT_TYPES));
+        std::abort();
+    }
+    return id;
+}
+
+template<typename T>
+struct ComponentTypeFamily {
+    static ComponentTypeId Id() noexcept {
+        static const ComponentTypeId s_id = NextComponentTypeId();
+        return s_id;
+    }
+};
+
+} // namespace Detail
+
+// Dense id of component type T (cv-qualifiers are ignored).
+template<typename T>
+[[nodiscard]] inline ComponentTypeId ComponentTypeOf() noexcept {
+    return Detail::ComponentTypeFamily<std::remove_cv_t<T>>::Id();
+}
+
+} // namespace Hotones::ECS
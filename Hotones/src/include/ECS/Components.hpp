@@ -1,8 +1,10 @@
 #pragma once
 
+#include <ECS/ComponentPool.hpp>
 #include <raylib.h>
 #include <raymath.h>
 #include <string>
+#include <vector>
 #include <cstdint>
 
 // Forward-declare the heavy Player class so this header stays light.
@@ -15,8 +17,8 @@ namespace Hotones { class Player; }
 // so they can live directly in the dense component arrays without indirection.
 //
 // Add new game-specific components freely in your own headers; you do NOT
-// need to register them anywhere — the Registry discovers them at first use
-// via std::type_index.
+// need to register them anywhere — each type is assigned a dense
+// ComponentTypeId at first use (see ComponentType.hpp).
 // ---------------------------------------------------------------------------
 
 namespace Hotones::ECS {
@@ -56,6 +58,32 @@ struct ColliderSphereComponent {
     bool    isStatic      = false; // if true, the physics system won't move it
 };
 
+// ---- Hierarchy ------------------------------------------------------------
+//
+// A child's TransformComponent is relative to its parent;
+// WorldTransformComponent holds the composed world matrix. Change the links
+// with SetParent / ClearParent (Hierarchy.hpp), which keep ParentComponent
+// and ChildrenComponent consistent, and let TransformHierarchySystem
+// (Systems.hpp) fill in the world transforms.
+
+/// Parent of a child entity in the transform hierarchy.
+struct ParentComponent {
+    EntityId parent = INVALID_ENTITY;
+};
+
+/// Direct children of an entity in the transform hierarchy.
+struct ChildrenComponent {
+    std::vector<EntityId> children;
+};
+
+/// World-space transform: the local TransformComponent composed with every
+/// ancestor's. Written by TransformHierarchySystem; read-only elsewhere.
+struct WorldTransformComponent {
+    Matrix matrix = MatrixIdentity();
+
+    [[nodiscard]] Vector3 Position() const noexcept { return { matrix.m12, matrix.m13, matrix.m14 }; }
+};
+
 // ---- Rendering ------------------------------------------------------------
 
 /// Holds a loaded raylib Model handle and render parameters.
@@ -169,4 +197,12 @@ struct PlayerComponent {
     float jumpMultiplier    = 1.0f;    ///< scales JUMP_FORCE (1.0 = default)
 };
 
+// ---- Storage --------------------------------------------------------------
+
+// Components that arrive in spawn waves (projectiles, pickups, effects) live
+// in ChunkedStorage so pool growth never reallocates mid-frame.
+template<> struct StorageType<TransformComponent> { using Type = ChunkedStorage<TransformComponent>; };
+template<> struct StorageType<VelocityComponent>  { using Type = ChunkedStorage<VelocityComponent>;  };
+template<> struct StorageType<LifetimeComponent>  { using Type = ChunkedStorage<LifetimeComponent>;  };
+
 } // namespace Hotones::ECS
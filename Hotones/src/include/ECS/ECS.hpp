@@ -13,9 +13,23 @@
 // --------
 //
 //   Entity        — uint32_t handle (index + generation)
+//   ComponentType — dense per-type integer ids (pool lookup is a vector index)
 //   ComponentPool — sparse-set per-component storage  O(1) add/remove/get
+//                   (PoolType<T> swaps in other layouts, e.g. KinematicPool)
+//   KinematicPool — structure-of-arrays pool + SIMD kernel for KinematicComponent
 //   Registry      — owns all pools; entity + component lifecycle + queries
+//                   (ParallelView / ParallelEach run on a Jobs::JobPool)
+//   Group         — owning group; packs entities with ALL of Ts for linear walks
+//   Query         — View / Each terms: const T, Changed<T>, Added<T>
+//   CommandBuffer — records create / destroy / add / remove for deferred playback
 //   System        — virtual base class for per-frame logic
+//   SystemScheduler — runs Systems as a dependency DAG on a Jobs::JobPool
+//   Hierarchy     — parent / child links (SetParent, DestroySubtree)
+//   Tags          — TagComponent name index (SetTag / FindByTag)
+//   Systems       — built-in systems (KinematicSystem, LifetimeSystem,
+//                   DeathSystem, TransformHierarchySystem)
+//   Snapshot      — binary Registry snapshot / restore (Registry::Serialize)
+//   Prefab        — component template spawned in bulk (Registry::Instantiate)
 //   Components    — built-in engine component structs
 //
 // Quick-start
@@ -28,7 +42,7 @@
 //   auto e = reg.CreateEntity();
 //   reg.AddComponent<TransformComponent>(e, Vector3{0, 1, 0});
 //   reg.AddComponent<VelocityComponent>(e, Vector3{0, 0, 5});
-//   reg.AddComponent<TagComponent>(e, "Bullet");
+//   reg.SetTag(e, "Bullet");                  // indexed: reg.FindByTag("Bullet")
 //
 //   // 3. Query from a System::Update (or inline in Scene::Update)
 //   reg.View<TransformComponent, VelocityComponent>(
@@ -42,7 +56,18 @@
 // ---------------------------------------------------------------------------
 
 #include <ECS/Entity.hpp>
+#include <ECS/ComponentType.hpp>
 #include <ECS/ComponentPool.hpp>
+#include <ECS/KinematicPool.hpp>
+#include <ECS/Group.hpp>
+#include <ECS/Query.hpp>
 #include <ECS/Registry.hpp>
+#include <ECS/CommandBuffer.hpp>
 #include <ECS/System.hpp>
+#include <ECS/SystemScheduler.hpp>
+#include <ECS/Hierarchy.hpp>
+#include <ECS/Tags.hpp>
+#include <ECS/Systems.hpp>
 #include <ECS/Components.hpp>
+#include <ECS/Snapshot.hpp>
+#include <ECS/Prefab.hpp>
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <ECS/Entity.hpp>
+#include <ECS/ComponentPool.hpp>
+#include <ECS/Query.hpp>
+
+#include <tuple>
+#include <vector>
+#include <cstddef>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// IGroup — type-erased base for OwningGroup<Ts...>.
+//
+// A group "owns" the pools of its component types: every entity that has
+// ALL of the group's components is kept in the first Size() dense slots of
+// each owned pool, in the same order. Iterating the group is therefore a
+// straight walk over parallel arrays with no membership tests.
+//
+// The Registry calls OnAdd after a component is emplaced into an owned pool
+// and OnRemove before a component is removed from one.
+// ---------------------------------------------------------------------------
+struct IGroup {
+    virtual ~IGroup() = default;
+
+    // Entity index idx just gained a component of one of the owned types.
+    virtual void OnAdd(uint32_t entityIdx) = 0;
+
+    // Entity index idx is about to lose a component of one of the owned types.
+    virtual void OnRemove(uint32_t entityIdx) = 0;
+
+    // Number of owned component types.
+    [[nodiscard]] virtual size_t TypeCount() const = 0;
+
+    // Number of entities currently packed at the front of the owned pools.
+    [[nodiscard]] size_t Size() const noexcept { return m_size; }
+
+    // Forget every member (the owned pools are being cleared).
+    void Reset() noexcept { m_size = 0; }
+
+protected:
+    size_t m_size = 0;
+};
+
+// ---------------------------------------------------------------------------
+// OwningGroup<Ts...> — keeps the pools of Ts sorted so that members share
+// the same packed prefix.
+//
+// Invariant: for every i < Size(), dense slot i of every owned pool belongs
+// to the same entity, and that entity owns every T in Ts.
+// ---------------------------------------------------------------------------
+template<typename... Ts>
+class OwningGroup final : public IGroup {
+public:
+    explicit OwningGroup(PoolOf<Ts>&... pools) : m_pools(&pools...) {}
+
+    void OnAdd(uint32_t entityIdx) override {
+        if (!(std::get<PoolOf<Ts>*>(m_pools)->Has(entityIdx) && ...)) return;
+        if (First().Index(entityIdx) < m_size) return; // already a member
+        (std::get<PoolOf<Ts>*>(m_pools)->SwapDense(
+             std::get<PoolOf<Ts>*>(m_pools)->Index(entityIdx),
+             static_cast<uint32_t>(m_size)), ...);
+        ++m_size;
+    }
+
+    void OnRemove(uint32_t entityIdx) override {
+        if (!(std::get<PoolOf<Ts>*>(m_pools)->Has(entityIdx) && ...)) return;
+        if (First().Index(entityIdx) >= m_size) return; // not a member
+        --m_size;
+        (std::get<PoolOf<Ts>*>(m_pools)->SwapDense(
+             std::get<PoolOf<Ts>*>(m_pools)->Index(entityIdx),
+             static_cast<uint32_t>(m_size)), ...);
+    }
+
+    [[nodiscard]] size_t TypeCount() const override { return sizeof...(Ts); }
+
+private:
+    using FirstT = std::tuple_element_t<0, std::tuple<Ts...>>;
+
+    [[nodiscard]] PoolOf<FirstT>& First() const {
+        return *std::get<0>(m_pools);
+    }
+
+    std::tuple<PoolOf<Ts>*...> m_pools;
+};
+
+// ---------------------------------------------------------------------------
+// GroupView<Ts...> — lightweight handle returned by Registry::Group<Ts...>().
+//
+// Ts may list the grouped types in any order. Cheap to copy; stays valid for
+// the lifetime of the Registry. Structural changes to the owned pools during
+// Each() follow the same rules as View.
+// ---------------------------------------------------------------------------
+template<typename... Ts>
+class GroupView {
+public:
+    GroupView(const IGroup& group, const std::vector<uint32_t>& generations,
+              PoolOf<Ts>&... pools)
+        : m_group(&group), m_generations(&generations), m_pools(&pools...) {}
+
+    [[nodiscard]] size_t Size() const noexcept { return m_group->Size(); }
+
+    // Calls fn(EntityId, Ts&...) for every member, in dense order, and marks
+    // every component handed out as changed.
+    template<typename Fn>
+    void Each(Fn&& fn) const {
+        const auto&  dense = std::get<0>(m_pools)->EntityIndices();
+        const size_t n     = m_group->Size();
+        for (size_t i = 0; i < n; ++i) {
+            const uint32_t idx = dense[i];
+            fn(MakeEntity(idx, (*m_generations)[idx]),
+               FetchSlot<Ts>(*std::get<PoolOf<Ts>*>(m_pools), i)...);
+        }
+    }
+
+private:
+    const IGroup*                     m_group;
+    const std::vector<uint32_t>*      m_generations;
+    std::tuple<PoolOf<Ts>*...> m_pools;
+};
+
+} // namespace Hotones::ECS
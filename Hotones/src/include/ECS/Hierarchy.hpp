@@ -0,0 +1,88 @@
+#pragma once
+
+#include <ECS/Entity.hpp>
+#include <ECS/Registry.hpp>
+#include <ECS/Components.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// Hierarchy.hpp — parent / child links between entities.
+//
+//   SetParent(reg, sword, hand);      // sword's Transform is now hand-relative
+//   ...
+//   ClearParent(reg, sword);          // sword is a root again
+//   DestroySubtree(reg, hand);        // hand and every descendant
+//
+// SetParent keeps ParentComponent (on the child) and ChildrenComponent (on
+// the parent) in step, and gives both entities a TransformComponent and a
+// WorldTransformComponent so TransformHierarchySystem can compose them.
+//
+// Destroying a parent with plain DestroyEntity leaves its children in
+// place: they are treated as roots until re-parented.
+// ---------------------------------------------------------------------------
+
+// Parent of id, or INVALID_ENTITY for roots and dead entities.
+[[nodiscard]] inline EntityId ParentOf(const Registry& reg, EntityId id) {
+    const auto* p = reg.TryGetComponent<ParentComponent>(id);
+    return p ? p->parent : INVALID_ENTITY;
+}
+
+// True if ancestor is id itself or one of its (live) ancestors.
+[[nodiscard]] inline bool IsDescendantOf(const Registry& reg, EntityId id, EntityId ancestor) {
+    for (EntityId e = id; e != INVALID_ENTITY && reg.IsAlive(e); e = ParentOf(reg, e))
+        if (e == ancestor) return true;
+    return false;
+}
+
+// Detach id from its parent (no-op for roots).
+inline void ClearParent(Registry& reg, EntityId id) {
+    const EntityId parent = ParentOf(reg, id);
+    if (parent == INVALID_ENTITY) return;
+    if (auto* c = reg.TryGetComponent<ChildrenComponent>(parent))
+        std::erase(c->children, id);
+    reg.RemoveComponent<ParentComponent>(id);
+}
+
+// Make child a child of parent (parent == INVALID_ENTITY detaches it).
+// Returns false — changing nothing — if either entity is dead or the link
+// would create a cycle.
+inline bool SetParent(Registry& reg, EntityId child, EntityId parent) {
+    if (!reg.IsAlive(child)) return false;
+    if (parent == INVALID_ENTITY) {
+        ClearParent(reg, child);
+        return true;
+    }
+    if (!reg.IsAlive(parent) || IsDescendantOf(reg, parent, child)) return false;
+    if (ParentOf(reg, child) == parent) return true;
+
+    ClearParent(reg, child);
+    reg.AddComponent<ParentComponent>(child, ParentComponent{ parent });
+    reg.GetOrAdd<ChildrenComponent>(parent).children.push_back(child);
+
+    for (const EntityId e : { child, parent }) {
+        (void)reg.GetOrAdd<TransformComponent>(e);
+        (void)reg.GetOrAdd<WorldTransformComponent>(e);
+    }
+    return true;
+}
+
+// Destroy root and every entity below it.
+inline void DestroySubtree(Registry& reg, EntityId root) {
+    if (!reg.IsAlive(root)) return;
+    ClearParent(reg, root);
+
+    std::vector<EntityId> doomed{ root };
+    for (size_t i = 0; i < doomed.size(); ++i) {
+        if (const auto* c = std::as_const(reg).TryGetComponent<ChildrenComponent>(doomed[i]))
+            for (const EntityId child : c->children)
+                if (ParentOf(reg, child) == doomed[i]) doomed.push_back(child);
+    }
+    reg.DestroyEntities(doomed);
+}
+
+} // namespace Hotones::ECS
@@ -0,0 +1,319 @@
+#pragma once
+
+#include <ECS/ComponentPool.hpp>
+
+#include <raylib.h>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define HOTONES_ECS_KINEMATIC_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define HOTONES_ECS_KINEMATIC_SSE2 1
+#endif
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// KinematicComponent — position, linear velocity and lifetime of a simple
+// moving entity (projectiles, particles, debris).
+//
+// Unlike the other built-in components it is NOT stored as an array of
+// structs: PoolOf<KinematicComponent> is a KinematicPool, which splits the
+// fields into one float stream per axis so KinematicPool::Integrate can
+// advance every entity with SIMD loads and stores.
+//
+// remaining counts down by dt every Integrate; the entity expires when it
+// reaches zero. Leave it at infinity for entities that never expire.
+// ---------------------------------------------------------------------------
+struct KinematicComponent {
+    Vector3 position  = { 0.0f, 0.0f, 0.0f };
+    Vector3 velocity  = { 0.0f, 0.0f, 0.0f }; // units per second
+    float   remaining = std::numeric_limits<float>::infinity(); // seconds
+};
+
+class KinematicPool;
+
+// ---------------------------------------------------------------------------
+// KinematicRef — handle to one KinematicComponent inside a KinematicPool.
+//
+// Returned by value where other pools hand out T& (Registry::AddComponent /
+// GetComponent, View, Each, GroupView), so callbacks take it as
+// `KinematicRef k` (or `auto k`), not `KinematicComponent&`:
+//
+//   reg.Each<KinematicComponent>([](EntityId id, KinematicRef k) {
+//       k.SetVelocity(Vector3Scale(k.Velocity(), 0.99f));
+//   });
+//
+// Same lifetime rules as a T&: do not hold across structural changes.
+// ---------------------------------------------------------------------------
+class KinematicRef {
+public:
+    KinematicRef(KinematicPool& pool, uint32_t slot) noexcept : m_pool(&pool), m_slot(slot) {}
+
+    [[nodiscard]] Vector3 Position()  const noexcept;
+    [[nodiscard]] Vector3 Velocity()  const noexcept;
+    [[nodiscard]] float   Remaining() const noexcept;
+
+    void SetPosition (Vector3 p) noexcept;
+    void SetVelocity (Vector3 v) noexcept;
+    void SetRemaining(float s)   noexcept;
+
+    // Copy the whole component out / in.
+    operator KinematicComponent() const noexcept {
+        return { Position(), Velocity(), Remaining() };
+    }
+    KinematicRef& operator=(const KinematicComponent& c) noexcept {
+        SetPosition(c.position);
+        SetVelocity(c.velocity);
+        SetRemaining(c.remaining);
+        return *this;
+    }
+
+private:
+    KinematicPool* m_pool;
+    uint32_t       m_slot;
+};
+
+// ---------------------------------------------------------------------------
+// KinematicPool — structure-of-arrays pool for KinematicComponent.
+//
+// Internals
+// ---------
+//   SparseSet           — entity index <-> dense slot mapping.
+//   m_px m_py m_pz      — position streams  (parallel to the dense indices)
+//   m_vx m_vy m_vz      — velocity streams
+//   m_life              — remaining lifetime stream
+//
+// Integrate runs position += velocity * dt and remaining -= dt over the
+// streams 8 lanes at a time with AVX2 (when compiled with -mavx2), 4 lanes
+// with SSE2 otherwise, and falls back to scalar code on other targets.
+// ---------------------------------------------------------------------------
+class KinematicPool : public SparseSet {
+public:
+    // ---- IPool interface ------------------------------------------------
+
+    void Remove(uint32_t entityIdx) override {
+        if (!Has(entityIdx)) return;
+
+        const uint32_t denseIdx = Index(entityIdx);
+        const uint32_t last     = static_cast<uint32_t>(Size()) - 1u;
+
+        for (auto* s : Streams()) {
+            (*s)[denseIdx] = (*s)[last];
+            s->pop_back();
+        }
+        Erase(entityIdx);
+    }
+
+    void Clear() override {
+        ClearIndices();
+        for (auto* s : Streams()) s->clear();
+    }
+
+    // ---- Typed interface ------------------------------------------------
+
+    KinematicRef Emplace(uint32_t entityIdx, const KinematicComponent& c = {}) {
+        assert(!Has(entityIdx) && "KinematicPool::Emplace — entity already owns this component");
+
+        const uint32_t slot = Insert(entityIdx);
+        m_px.push_back(c.position.x); m_py.push_back(c.position.y); m_pz.push_back(c.position.z);
+        m_vx.push_back(c.velocity.x); m_vy.push_back(c.velocity.y); m_vz.push_back(c.velocity.z);
+        m_life.push_back(c.remaining);
+        return { *this, slot };
+    }
+    KinematicRef Emplace(uint32_t entityIdx, Vector3 position, Vector3 velocity = { 0.0f, 0.0f, 0.0f },
+                         float remaining = std::numeric_limits<float>::infinity()) {
+        return Emplace(entityIdx, KinematicComponent{ position, velocity, remaining });
+    }
+
+    // Give every entity in entityIdx a copy of c, with one reserve up front.
+    void EmplaceN(std::span<const uint32_t> entityIdx, const KinematicComponent& c) {
+        Reserve(Size() + entityIdx.size());
+        for (const uint32_t idx : entityIdx) {
+            assert(!Has(idx) && "KinematicPool::EmplaceN — entity already owns this component");
+            Insert(idx);
+        }
+        const size_t n = entityIdx.size();
+        m_px.insert(m_px.end(), n, c.position.x);
+        m_py.insert(m_py.end(), n, c.position.y);
+        m_pz.insert(m_pz.end(), n, c.position.z);
+        m_vx.insert(m_vx.end(), n, c.velocity.x);
+        m_vy.insert(m_vy.end(), n, c.velocity.y);
+        m_vz.insert(m_vz.end(), n, c.velocity.z);
+        m_life.insert(m_life.end(), n, c.remaining);
+    }
+
+    // Make room for n components in total.
+    void Reserve(size_t n) {
+        SparseSet::Reserve(n);
+        for (auto* s : Streams()) s->reserve(n);
+    }
+
+    // Behaviour is undefined if Has(entityIdx) is false.
+    // The mutable overload marks the component changed.
+    [[nodiscard]] KinematicRef Get(uint32_t entityIdx) {
+        assert(Has(entityIdx) && "KinematicPool::Get — entity does not own this component");
+        const uint32_t slot = Index(entityIdx);
+        MarkChanged(slot);
+        return { *this, slot };
+    }
+    [[nodiscard]] KinematicComponent Get(uint32_t entityIdx) const {
+        assert(Has(entityIdx) && "KinematicPool::Get — entity does not own this component");
+        return At(Index(entityIdx));
+    }
+
+    // Exchange two dense slots (entity index and every stream) in place.
+    void SwapDense(uint32_t a, uint32_t b) {
+        if (a == b) return;
+        for (auto* s : Streams()) std::swap((*s)[a], (*s)[b]);
+        SwapSlots(a, b);
+    }
+
+    // Dense-slot accessor used by Registry::Each and GroupView:
+    // Components()[i] is the component in dense slot i (not change-tracked).
+    class Slots {
+    public:
+        explicit Slots(KinematicPool& pool) noexcept : m_pool(&pool) {}
+        [[nodiscard]] KinematicRef operator[](size_t i) const noexcept {
+            return { *m_pool, static_cast<uint32_t>(i) };
+        }
+    private:
+        KinematicPool* m_pool;
+    };
+    class ConstSlots {
+    public:
+        explicit ConstSlots(const KinematicPool& pool) noexcept : m_pool(&pool) {}
+        [[nodiscard]] KinematicComponent operator[](size_t i) const { return m_pool->At(i); }
+    private:
+        const KinematicPool* m_pool;
+    };
+    [[nodiscard]] Slots      Components()       { return Slots(*this); }
+    [[nodiscard]] ConstSlots Components() const { return ConstSlots(*this); }
+
+    // Component in dense slot i, by value.
+    [[nodiscard]] KinematicComponent At(size_t i) const {
+        return { { m_px[i], m_py[i], m_pz[i] }, { m_vx[i], m_vy[i], m_vz[i] }, m_life[i] };
+    }
+
+    // ---- Streams --------------------------------------------------------
+
+    // Raw per-field arrays, each Size() long and parallel to EntityIndices().
+    // Writes through them are not change-tracked (see MarkChanged).
+    [[nodiscard]] float* PosX() noexcept { return m_px.data(); }
+    [[nodiscard]] float* PosY() noexcept { return m_py.data(); }
+    [[nodiscard]] float* PosZ() noexcept { return m_pz.data(); }
+    [[nodiscard]] float* VelX() noexcept { return m_vx.data(); }
+    [[nodiscard]] float* VelY() noexcept { return m_vy.data(); }
+    [[nodiscard]] float* VelZ() noexcept { return m_vz.data(); }
+    [[nodiscard]] float* Life() noexcept { return m_life.data(); }
+
+    // ---- Integration ----------------------------------------------------
+
+    // Advance every component by dt: position += velocity * dt and
+    // remaining -= dt, and marks them changed. Appends the entity index of
+    // every component whose remaining dropped to zero or below to
+    // `expired`; the components are NOT removed (destroy the entities
+    // afterwards, outside any iteration).
+    void Integrate(float dt, std::vector<uint32_t>& expired) {
+        Integrate(0, Size(), dt, expired);
+    }
+
+    // As above, for dense slots [begin, end) only.
+    void Integrate(size_t begin, size_t end, float dt, std::vector<uint32_t>& expired) {
+        assert(begin <= end && end <= Size());
+        const auto& dense = EntityIndices();
+        MarkChanged(begin, end);
+        size_t i = begin;
+
+#if defined(HOTONES_ECS_KINEMATIC_AVX2)
+        const __m256 vdt  = _mm256_set1_ps(dt);
+        const __m256 zero = _mm256_setzero_ps();
+        for (; i + 8 <= end; i += 8) {
+            Axis8(m_px.data() + i, m_vx.data() + i, vdt);
+            Axis8(m_py.data() + i, m_vy.data() + i, vdt);
+            Axis8(m_pz.data() + i, m_vz.data() + i, vdt);
+
+            const __m256 life = _mm256_sub_ps(_mm256_loadu_ps(m_life.data() + i), vdt);
+            _mm256_storeu_ps(m_life.data() + i, life);
+            const int mask = _mm256_movemask_ps(_mm256_cmp_ps(life, zero, _CMP_LE_OQ));
+            if (!mask) continue;
+            for (int lane = 0; lane < 8; ++lane)
+                if (mask & (1 << lane)) expired.push_back(dense[i + static_cast<size_t>(lane)]);
+        }
+#elif defined(HOTONES_ECS_KINEMATIC_SSE2)
+        const __m128 vdt  = _mm_set1_ps(dt);
+        const __m128 zero = _mm_setzero_ps();
+        for (; i + 4 <= end; i += 4) {
+            Axis4(m_px.data() + i, m_vx.data() + i, vdt);
+            Axis4(m_py.data() + i, m_vy.data() + i, vdt);
+            Axis4(m_pz.data() + i, m_vz.data() + i, vdt);
+
+            const __m128 life = _mm_sub_ps(_mm_loadu_ps(m_life.data() + i), vdt);
+            _mm_storeu_ps(m_life.data() + i, life);
+            const int mask = _mm_movemask_ps(_mm_cmple_ps(life, zero));
+            if (!mask) continue;
+            for (int lane = 0; lane < 4; ++lane)
+                if (mask & (1 << lane)) expired.push_back(dense[i + static_cast<size_t>(lane)]);
+        }
+#endif
+
+        // Scalar tail (and the whole range on targets without SIMD).
+        for (; i < end; ++i) {
+            m_px[i] += m_vx[i] * dt;
+            m_py[i] += m_vy[i] * dt;
+            m_pz[i] += m_vz[i] * dt;
+            if ((m_life[i] -= dt) <= 0.0f) expired.push_back(dense[i]);
+        }
+    }
+
+private:
+    friend class KinematicRef;
+
+    [[nodiscard]] std::array<std::vector<float>*, 7> Streams() noexcept {
+        return { &m_px, &m_py, &m_pz, &m_vx, &m_vy, &m_vz, &m_life };
+    }
+
+#if defined(HOTONES_ECS_KINEMATIC_AVX2)
+    static void Axis8(float* p, const float* v, __m256 dt) noexcept {
+        _mm256_storeu_ps(p, _mm256_add_ps(_mm256_loadu_ps(p), _mm256_mul_ps(_mm256_loadu_ps(v), dt)));
+    }
+#elif defined(HOTONES_ECS_KINEMATIC_SSE2)
+    static void Axis4(float* p, const float* v, __m128 dt) noexcept {
+        _mm_storeu_ps(p, _mm_add_ps(_mm_loadu_ps(p), _mm_mul_ps(_mm_loadu_ps(v), dt)));
+    }
+#endif
+
+    std::vector<float> m_px, m_py, m_pz;
+    std::vector<float> m_vx, m_vy, m_vz;
+    std::vector<float> m_life;
+};
+
+inline Vector3 KinematicRef::Position() const noexcept {
+    return { m_pool->m_px[m_slot], m_pool->m_py[m_slot], m_pool->m_pz[m_slot] };
+}
+inline Vector3 KinematicRef::Velocity() const noexcept {
+    return { m_pool->m_vx[m_slot], m_pool->m_vy[m_slot], m_pool->m_vz[m_slot] };
+}
+inline float KinematicRef::Remaining() const noexcept { return m_pool->m_life[m_slot]; }
+
+inline void KinematicRef::SetPosition(Vector3 p) noexcept {
+    m_pool->m_px[m_slot] = p.x; m_pool->m_py[m_slot] = p.y; m_pool->m_pz[m_slot] = p.z;
+}
+inline void KinematicRef::SetVelocity(Vector3 v) noexcept {
+    m_pool->m_vx[m_slot] = v.x; m_pool->m_vy[m_slot] = v.y; m_pool->m_vz[m_slot] = v.z;
+}
+inline void KinematicRef::SetRemaining(float s) noexcept { m_pool->m_life[m_slot] = s; }
+
+// Store KinematicComponent in a KinematicPool (see PoolType in ComponentPool.hpp).
+template<> struct PoolType<KinematicComponent> { using Type = KinematicPool; };
+
+} // namespace Hotones::ECS
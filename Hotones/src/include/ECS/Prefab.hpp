@@ -0,0 +1,149 @@
+#pragma once
+
+#include <ECS/Entity.hpp>
+#include <ECS/ComponentType.hpp>
+#include <ECS/Registry.hpp>
+#include <ECS/Components.hpp>
+#include <ECS/Tags.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// Prefab — a captured set of component values to spawn many times.
+//
+//   Prefab bullet;
+//   bullet.Set(TransformComponent{ muzzle })
+//         .Set(VelocityComponent{ Vector3Scale(dir, 50.0f) })
+//         .Set(LifetimeComponent{ 3.0f });
+//
+//   EntityId ids[500];
+//   reg.Instantiate(bullet, ids);           // 500 entities, 3 components each
+//
+// Instantiate creates the entities in one CreateEntities call, then fills
+// each pool in one pass: a single reserve for the whole batch, then the
+// component copies appended back to back (a fill for vector-backed pools).
+// Compared to CreateEntity + AddComponent per entity, there is no pool
+// lookup or possible reallocation per component.
+//
+// A Prefab owns copies of its values and may be reused, copied and shared
+// between Registries. Capture<Ts...> builds one from an existing entity.
+// ---------------------------------------------------------------------------
+class Prefab {
+public:
+    // Add component value to the prefab, replacing any earlier T.
+    template<typename T>
+    Prefab& Set(T value) {
+        static_assert(!std::is_const_v<T>, "Prefab::Set — use a non-const component type");
+        const ComponentTypeId type = ComponentTypeOf<T>();
+        auto stored = std::make_shared<const T>(std::move(value));
+        auto it = std::find_if(m_entries.begin(), m_entries.end(),
+                               [type](const Entry& e) { return e.type == type; });
+        if (it != m_entries.end()) {
+            it->value = std::move(stored);
+            return *this;
+        }
+        m_entries.push_back({ type, std::move(stored), &Spawn<T> });
+        m_mask.set(type);
+        return *this;
+    }
+
+    // Remove T from the prefab (no-op if it has none).
+    template<typename T>
+    Prefab& Unset() {
+        const ComponentTypeId type = ComponentTypeOf<T>();
+        std::erase_if(m_entries, [type](const Entry& e) { return e.type == type; });
+        m_mask.reset(type);
+        return *this;
+    }
+
+    template<typename T>
+    [[nodiscard]] bool Has() const noexcept { return m_mask.test(ComponentTypeOf<T>()); }
+
+    // The prefab's T, or nullptr.
+    template<typename T>
+    [[nodiscard]] const T* TryGet() const {
+        const ComponentTypeId type = ComponentTypeOf<T>();
+        for (const Entry& e : m_entries)
+            if (e.type == type) return static_cast<const T*>(e.value.get());
+        return nullptr;
+    }
+
+    // Every component type in the prefab.
+    [[nodiscard]] const ComponentMask& Mask() const noexcept { return m_mask; }
+    [[nodiscard]] bool Empty() const noexcept { return m_entries.empty(); }
+
+    // Prefab holding a copy of each of Ts that entity id owns.
+    template<typename... Ts>
+    [[nodiscard]] static Prefab Capture(const Registry& reg, EntityId id) {
+        Prefab prefab;
+        ([&] {
+            if (const auto* c = reg.TryGetComponent<Ts>(id)) prefab.Set<Ts>(*c);
+        }(), ...);
+        return prefab;
+    }
+
+private:
+    friend class Registry;
+
+    // Appends a copy of *value to pool T for every entity index in idx.
+    using SpawnFn = void (*)(Registry&, const void* value, std::span<const uint32_t> idx);
+
+    struct Entry {
+        ComponentTypeId             type;
+        std::shared_ptr<const void> value;
+        SpawnFn                     spawn;
+    };
+
+    template<typename T>
+    static void Spawn(Registry& reg, const void* value, std::span<const uint32_t> idx) {
+        reg.Pool<T>().EmplaceN(idx, *static_cast<const T*>(value));
+    }
+
+    std::vector<Entry> m_entries;
+    ComponentMask      m_mask;
+};
+
+// ---------------------------------------------------------------------------
+// Registry::Instantiate — declared in Registry.hpp
+// ---------------------------------------------------------------------------
+
+inline void Registry::Instantiate(const Prefab& prefab, std::span<EntityId> out) {
+    if (out.empty()) return;
+    CreateEntities(out);
+
+    std::vector<uint32_t> indices(out.size());
+    std::transform(out.begin(), out.end(), indices.begin(),
+                   [](EntityId id) { return EntityIndex(id); });
+
+    for (const Prefab::Entry& e : prefab.m_entries) {
+        e.spawn(*this, e.value.get(), indices);
+        if (ComponentEvents* events = m_pools[e.type]->Events())
+            events->constructed.insert(events->constructed.end(), out.begin(), out.end());
+    }
+    for (const uint32_t idx : indices) m_masks[idx] |= prefab.m_mask;
+
+    if (const auto* tag = prefab.TryGet<TagComponent>()) IndexTag(tag->name, out);
+
+    // Owning groups pack their new members once every component is in place.
+    std::vector<IGroup*> packed;
+    for (const Prefab::Entry& e : prefab.m_entries) {
+        IGroup* group = m_pools[e.type]->Owner();
+        if (!group || std::find(packed.begin(), packed.end(), group) != packed.end()) continue;
+        packed.push_back(group);
+        for (const uint32_t idx : indices) group->OnAdd(idx);
+    }
+}
+
+inline std::vector<EntityId> Registry::Instantiate(const Prefab& prefab, size_t count) {
+    std::vector<EntityId> ids(count);
+    Instantiate(prefab, std::span<EntityId>(ids));
+    return ids;
+}
+
+} // namespace Hotones::ECS
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <ECS/ComponentPool.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// Query terms — the type arguments accepted by Registry::View / Each.
+//
+//   T            entity must own T; fn receives T& and T is marked changed
+//   const T      entity must own T; fn receives const T& (not marked)
+//   Changed<T>   as T, but only if T was added or marked changed at or
+//                after the query's `since` tick
+//   Added<T>     as T, but only if T was added at or after `since`
+//
+// Filters wrap const types too (Changed<const T>) to observe without
+// marking:
+//
+//   reg.View<Changed<const TransformComponent>, const NetworkComponent>(
+//       [&](EntityId id, const TransformComponent& t, const NetworkComponent& n) {
+//           Replicate(n.peerId, id, t.position);
+//       });
+//
+// Change ticks are coarse: a component counts as changed when it is handed
+// out for writing, whether or not the callback actually writes it.
+// ---------------------------------------------------------------------------
+template<typename T> struct Changed {};
+template<typename T> struct Added   {};
+
+namespace Detail {
+
+enum class QueryFilter : uint8_t { None, Changed, Added };
+
+template<typename Q>
+struct QueryTerm {
+    using Type = Q;
+    static constexpr QueryFilter filter = QueryFilter::None;
+};
+template<typename T>
+struct QueryTerm<Changed<T>> {
+    using Type = T;
+    static constexpr QueryFilter filter = QueryFilter::Changed;
+};
+template<typename T>
+struct QueryTerm<Added<T>> {
+    using Type = T;
+    static constexpr QueryFilter filter = QueryFilter::Added;
+};
+
+} // namespace Detail
+
+// Component type (with its const) named by query term Q.
+template<typename Q>
+using QueryComponent = typename Detail::QueryTerm<Q>::Type;
+
+// True if dense slot `slot` of pool passes the filter of query term Q.
+template<typename Q>
+[[nodiscard]] inline bool MatchesFilter(const SparseSet& pool, size_t slot, uint32_t since) noexcept {
+    constexpr auto filter = Detail::QueryTerm<Q>::filter;
+    if constexpr (filter == Detail::QueryFilter::Changed) return pool.ChangedTick(slot) >= since;
+    else if constexpr (filter == Detail::QueryFilter::Added) return pool.AddedTick(slot) >= since;
+    else return true;
+}
+
+// Component in dense slot `slot` as handed to a query callback for
+// component type T: marks it changed and returns T& (or the pool's
+// reference type) unless T is const.
+template<typename T, typename Pool>
+[[nodiscard]] inline decltype(auto) FetchSlot(Pool& pool, size_t slot) {
+    if constexpr (std::is_const_v<T>) {
+        return std::as_const(pool).Components()[slot];
+    } else {
+        pool.MarkChanged(slot);
+        return pool.Components()[slot];
+    }
+}
+
+} // namespace Hotones::ECS
@@ -1,29 +1,53 @@
 #pragma once
 
 #include <ECS/Entity.hpp>
+#include <ECS/ComponentType.hpp>
 #include <ECS/ComponentPool.hpp>
+#include <ECS/Group.hpp>
+#include <ECS/Query.hpp>
+#include <Jobs/JobPool.hpp>
 
-#include <typeindex>
-#include <typeinfo>
-#include <unordered_map>
+#include <functional>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 #include <queue>
+#include <span>
+#include <type_traits>
 #include <algorithm>
 #include <cassert>
 
 namespace Hotones::ECS {
 
+class Prefab;
+class SnapshotSchema;
+struct TagComponent;
+
 // ---------------------------------------------------------------------------
 // Registry — the central ECS world object.
 //
 // Responsibilities
 // ----------------
 //  • Entity lifecycle  : CreateEntity / DestroyEntity / IsAlive
-//  • Component API     : AddComponent / GetComponent / HasComponent /
+//                        CreateEntities / DestroyEntities (bulk)
+//  • Component API     : AddComponent / GetComponent / HasComponent(s) /
 //                        RemoveComponent / GetOrAdd
 //  • Querying          : View<Ts...>  iterate entities with ALL of Ts
 //                        Each<T>      iterate every entity with a single T
+//                        Group<Ts...> declare an owning group; members of
+//                                     Ts are packed so View<Ts...> becomes a
+//                                     linear walk with no membership tests
+//                        ParallelView / ParallelEach
+//                                     chunked View / Each on a JobPool
+//  • Change tracking   : AdvanceTick / CurrentTick, with Changed<T> /
+//                        Added<T> query filters (see Query.hpp)
+//  • Snapshots         : Serialize / Deserialize (see Snapshot.hpp)
+//  • Prefabs           : Instantiate (bulk spawn; see Prefab.hpp)
+//  • Observers         : OnConstruct / OnDestroy, delivered in batches by
+//                        DispatchEvents
+//  • Tag index         : SetTag / FindByTag (see Tags.hpp)
 //
 // Usage example
 // -------------
@@ -43,12 +67,20 @@ namespace Hotones::ECS {
 //   The Registry is NOT thread-safe. Wrap external access in a mutex if you
 //   call it from multiple threads.
 //
+//   ParallelView / ParallelEach are the one exception: they run fn on
+//   several threads at once, so fn may only read or write the components it
+//   is handed (plus data no other chunk touches) and must not make any
+//   structural change to the Registry — not even through a shared
+//   CommandBuffer.
+//
 // Mutation during View / Each
 // ---------------------------
-//   AddComponent / RemoveComponent / DestroyEntity inside a View callback
-//   for one of the iterated component types is NOT safe and may cause missed
-//   or double-processed entities. Defer such mutations with a command queue
-//   and flush them after the view completes.
+//   View / Each walk the live dense arrays in place (no per-call copy), so
+//   AddComponent / RemoveComponent / DestroyEntity inside a callback for one
+//   of the iterated component types is NOT safe: it may cause missed or
+//   double-processed entities and invalidates the references handed to fn.
+//   Record such mutations in a CommandBuffer and Flush it after the view
+//   completes. CreateEntity and components of other types are fine.
 // ---------------------------------------------------------------------------
 
 class Registry {
@@ -56,7 +88,7 @@ public:
     Registry()  = default;
     ~Registry() = default;
 
-    // Non-copyable; move is fine.
+    // Non-copyable; move is fine (pools keep pointing at the moved clock).
     Registry(const Registry&)            = delete;
     Registry& operator=(const Registry&) = delete;
     Registry(Registry&&)                 = default;
@@ -75,25 +107,69 @@ public:
         } else {
             idx = static_cast<uint32_t>(m_generations.size());
             m_generations.push_back(0u);
+            m_masks.emplace_back();
+            m_alivePos.push_back(0u);
         }
         const EntityId id = MakeEntity(idx, m_generations[idx]);
+        m_alivePos[idx] = static_cast<uint32_t>(m_alive.size());
         m_alive.push_back(id);
         return id;
     }
 
+    // Create out.size() entities at once, writing their ids into out.
+    void CreateEntities(std::span<EntityId> out) {
+        const size_t fresh = out.size() > m_freeList.size() ? out.size() - m_freeList.size() : 0;
+        m_alive      .reserve(m_alive.size() + out.size());
+        m_generations.reserve(m_generations.size() + fresh);
+        m_masks      .reserve(m_masks.size() + fresh);
+        m_alivePos   .reserve(m_alivePos.size() + fresh);
+        for (auto& id : out) id = CreateEntity();
+    }
+
+    [[nodiscard]] std::vector<EntityId> CreateEntities(size_t count) {
+        std::vector<EntityId> ids(count);
+        CreateEntities(std::span<EntityId>(ids));
+        return ids;
+    }
+
     // Destroy an entity: removes all its components and invalidates the id.
+    // O(number of components the entity owns).
     void DestroyEntity(EntityId id) {
         if (!IsAlive(id)) return;
         const uint32_t idx = EntityIndex(id);
-        // Strip every component pool
-        for (auto& [ti, pool] : m_pools)
-            pool->Remove(idx);
-        // Bump generation so the old EntityId becomes stale
-        ++m_generations[idx];
-        m_freeList.push(idx);
-        // Remove from alive list
-        auto it = std::find(m_alive.begin(), m_alive.end(), id);
-        if (it != m_alive.end()) m_alive.erase(it);
+        // Strip only the pools the entity actually uses
+        ComponentMask& mask = m_masks[idx];
+        for (ComponentTypeId type = 0; mask.any() && type < m_pools.size(); ++type) {
+            if (!mask.test(type)) continue;
+            RemoveAt(*m_pools[type], idx);
+            mask.reset(type);
+        }
+        Release(idx);
+    }
+
+    // Destroy every live entity in ids (stale ids and duplicates are ignored).
+    // Components are stripped pool by pool, touching only pools that at least
+    // one of the entities uses.
+    void DestroyEntities(std::span<const EntityId> ids) {
+        ComponentMask used;
+        for (const EntityId id : ids)
+            if (IsAlive(id)) used |= m_masks[EntityIndex(id)];
+
+        for (ComponentTypeId type = 0; used.any() && type < m_pools.size(); ++type) {
+            if (!used.test(type)) continue;
+            IPool& pool = *m_pools[type];
+            for (const EntityId id : ids) {
+                if (!IsAlive(id)) continue;
+                const uint32_t idx = EntityIndex(id);
+                if (!m_masks[idx].test(type)) continue;
+                RemoveAt(pool, idx);
+                m_masks[idx].reset(type);
+            }
+            used.reset(type);
+        }
+
+        for (const EntityId id : ids)
+            if (IsAlive(id)) Release(EntityIndex(id));
     }
 
     // Returns true if the entity has not been destroyed (generation matches).
@@ -103,6 +179,14 @@ public:
             && EntityGeneration(id) == m_generations[idx];
     }
 
+    // Current EntityId of entity slot idx — e.g. to turn the entity indices
+    // reported by a pool (EntityIndices, KinematicPool::Integrate) back into
+    // ids. Only meaningful while that slot is alive.
+    [[nodiscard]] EntityId EntityAt(uint32_t idx) const noexcept {
+        assert(idx < m_generations.size() && "Registry::EntityAt — index out of range");
+        return MakeEntity(idx, m_generations[idx]);
+    }
+
     // All currently live entities (order is not guaranteed).
     [[nodiscard]] const std::vector<EntityId>& Entities() const noexcept {
         return m_alive;
@@ -113,40 +197,107 @@ public:
     // Destroy every entity and clear every component pool.
     void Clear() {
         m_alive.clear();
+        m_alivePos.clear();
         m_generations.clear();
+        m_masks.clear();
         while (!m_freeList.empty()) m_freeList.pop();
-        for (auto& [ti, pool] : m_pools) pool->Clear();
+        for (auto& pool : m_pools) if (pool) pool->Clear();
+        for (auto& group : m_groups) group->Reset();
+        for (auto& obs : m_observers) {
+            if (!obs) continue;
+            obs->events.constructed.clear();
+            obs->events.destroyed.clear();
+        }
+        m_tagIndex.clear();
+        m_tagSlots.clear();
     }
 
+    // -----------------------------------------------------------------------
+    // Change tracking
+    // -----------------------------------------------------------------------
+
+    // Every pool stamps a component with the current tick when it is added
+    // and whenever it is handed out for writing (mutable GetComponent /
+    // TryGetComponent / GetOrAdd, View / Each over a non-const T).
+    // Changed<T> / Added<T> query terms compare against those stamps.
+    //
+    // Call AdvanceTick once per frame (before the frame's systems run) so
+    // "changed during the current tick" means "changed this frame".
+    uint32_t AdvanceTick() noexcept { return ++m_clock->tick; }
+    [[nodiscard]] uint32_t CurrentTick() const noexcept { return m_clock->tick; }
+
     // -----------------------------------------------------------------------
     // Component API
     // -----------------------------------------------------------------------
 
     // Construct a T in-place on entity id from args.
     // Asserts the entity is alive and does not already own a T.
+    //
+    // Returns T& — or the pool's reference type for component types with
+    // their own storage layout (see PoolType<T>), e.g. KinematicRef.
     template<typename T, typename... Args>
-    T& AddComponent(EntityId id, Args&&... args) {
+    decltype(auto) AddComponent(EntityId id, Args&&... args) {
         assert(IsAlive(id) && "Registry::AddComponent — entity is not alive");
-        return Pool<T>().Emplace(EntityIndex(id), std::forward<Args>(args)...);
+        auto& pool = Pool<T>();
+        const uint32_t idx = EntityIndex(id);
+        pool.Emplace(idx, std::forward<Args>(args)...);
+        m_masks[idx].set(ComponentTypeOf<T>());
+        // A group may have moved the new component into its packed prefix.
+        if (pool.Owner()) pool.Owner()->OnAdd(idx);
+        if (ComponentEvents* events = pool.Events()) events->constructed.push_back(id);
+        if constexpr (std::is_same_v<std::remove_cv_t<T>, TagComponent>)
+            IndexTag(pool.Get(idx).name, std::span<const EntityId>(&id, 1));
+        return pool.Get(idx);
     }
 
-    // Returns true if entity id owns a component of type T.
+    // Returns true if entity id is alive and owns a component of type T.
     template<typename T>
     [[nodiscard]] bool HasComponent(EntityId id) const {
+        return IsAlive(id) && m_masks[EntityIndex(id)].test(ComponentTypeOf<T>());
+    }
+
+    // Returns true if entity id is alive and owns ALL of Ts — one masked
+    // compare of its component signature, however many types are listed.
+    template<typename... Ts>
+    [[nodiscard]] bool HasComponents(EntityId id) const {
+        return IsAlive(id) && HasAllAt<Ts...>(EntityIndex(id));
+    }
+
+    // Component signature of a live entity: bit ComponentTypeOf<T>() is set
+    // for every T it owns. For queries whose types are only known at run
+    // time (e.g. the Lua bindings); compiled code should use HasComponents.
+    [[nodiscard]] const ComponentMask& Signature(EntityId id) const {
+        assert(IsAlive(id) && "Registry::Signature — entity is not alive");
+        return m_masks[EntityIndex(id)];
+    }
+
+    // Returns a pointer to the T owned by entity id, or nullptr if the entity
+    // is dead or does not own one. One pool lookup instead of Has + Get.
+    template<typename T>
+    [[nodiscard]] T* TryGetComponent(EntityId id) {
+        if (!IsAlive(id)) return nullptr;
+        auto* p = PoolPtr<T>();
+        const uint32_t idx = EntityIndex(id);
+        return p && p->Has(idx) ? &p->Get(idx) : nullptr;
+    }
+    template<typename T>
+    [[nodiscard]] const T* TryGetComponent(EntityId id) const {
+        if (!IsAlive(id)) return nullptr;
         const auto* p = PoolPtr<T>();
-        return p && p->Has(EntityIndex(id));
+        const uint32_t idx = EntityIndex(id);
+        return p && p->Has(idx) ? &p->Get(idx) : nullptr;
     }
 
     // Returns a reference to the T owned by entity id.
     // Asserts the entity is alive and owns a T.
     template<typename T>
-    [[nodiscard]] T& GetComponent(EntityId id) {
+    [[nodiscard]] decltype(auto) GetComponent(EntityId id) {
         assert(IsAlive(id)        && "Registry::GetComponent — entity is not alive");
         assert(HasComponent<T>(id) && "Registry::GetComponent — entity does not own component");
         return Pool<T>().Get(EntityIndex(id));
     }
     template<typename T>
-    [[nodiscard]] const T& GetComponent(EntityId id) const {
+    [[nodiscard]] decltype(auto) GetComponent(EntityId id) const {
         assert(IsAlive(id)        && "Registry::GetComponent — entity is not alive");
         assert(HasComponent<T>(id) && "Registry::GetComponent — entity does not own component");
         return PoolConst<T>().Get(EntityIndex(id));
@@ -155,12 +306,18 @@ public:
     // Remove T from entity id (no-op if it doesn't own one).
     template<typename T>
     void RemoveComponent(EntityId id) {
-        if (auto* p = PoolPtr<T>()) p->Remove(EntityIndex(id));
+        if (!IsAlive(id)) return;
+        const uint32_t        idx  = EntityIndex(id);
+        const ComponentTypeId type = ComponentTypeOf<T>();
+        if (!m_masks[idx].test(type)) return;
+        RemoveAt(*m_pools[type], idx);
+        m_masks[idx].reset(type);
+        if constexpr (std::is_same_v<std::remove_cv_t<T>, TagComponent>) UnindexTag(idx);
     }
 
     // If entity id already owns a T, return it; otherwise default-construct one.
     template<typename T>
-    T& GetOrAdd(EntityId id) {
+    decltype(auto) GetOrAdd(EntityId id) {
         if (!HasComponent<T>(id)) AddComponent<T>(id);
         return GetComponent<T>(id);
     }
@@ -172,76 +329,360 @@ public:
     // View<Ts...>(fn) — calls fn(EntityId, Ts&...) for every entity that
     // owns ALL of the listed component types.
     //
-    // The iteration order is determined by the smallest component pool.
-    // A snapshot of entity indices is taken before the loop starts, so
-    // adding entities during iteration is safe; removing the *iterated*
-    // component types mid-loop is NOT.
+    // Ts are query terms (see Query.hpp): `const T` to read without marking
+    // T changed, Changed<T> / Added<T> to only visit components changed /
+    // added during the current tick (or since `since`, below).
+    //
+    // The iteration order is determined by the smallest component pool,
+    // which is walked in place. Defer structural changes to the iterated
+    // component types through a CommandBuffer (see class comment).
     template<typename... Ts, typename Fn>
     void View(Fn&& fn) {
+        View<Ts...>(CurrentTick(), std::forward<Fn>(fn));
+    }
+
+    // As above; Changed / Added terms match components changed / added at
+    // or after tick `since`.
+    template<typename... Ts, typename Fn>
+    void View(uint32_t since, Fn&& fn) {
         static_assert(sizeof...(Ts) > 0, "View requires at least one component type");
 
-        IPool* smallest = FindSmallestPool<Ts...>();
+        IPool* smallest = FindSmallestPool<QueryComponent<Ts>...>();
         if (!smallest || smallest->Size() == 0) return;
 
-        // Snapshot the dense index list to avoid iterator invalidation.
-        const auto idxList = smallest->EntityIndices();
+        const auto pools = std::make_tuple(PoolPtr<QueryComponent<Ts>>()...);
+
+        // Fast path: an owning group over exactly Ts keeps every match in the
+        // same packed prefix of each pool — walk it without any lookups.
+        if (const IGroup* group = OwningGroupOf<QueryComponent<Ts>...>()) {
+            const auto&  dense = std::get<0>(pools)->EntityIndices();
+            const size_t n     = group->Size();
+            for (size_t i = 0; i < n; ++i) {
+                if (!(MatchesFilter<Ts>(TermPool<Ts>(pools), i, since) && ...)) continue;
+                const uint32_t idx = dense[i];
+                fn(MakeEntity(idx, m_generations[idx]),
+                   FetchSlot<QueryComponent<Ts>>(TermPool<Ts>(pools), i)...);
+            }
+            return;
+        }
+
+        // Membership is one masked compare of the entity's signature.
+        const ComponentMask& required = MaskOf<QueryComponent<Ts>...>();
+        const auto&          dense    = smallest->EntityIndices();
 
-        for (const uint32_t idx : idxList) {
-            if (!HasAllAt<Ts...>(idx)) continue;
+        for (size_t i = 0; i < dense.size(); ++i) {
+            const uint32_t idx = dense[i];
+            if ((m_masks[idx] & required) != required) continue;
+            if (!(MatchesFilter<Ts>(TermPool<Ts>(pools), TermPool<Ts>(pools).Index(idx), since) && ...))
+                continue;
             // Rebuild the live EntityId for this slot.
-            if (idx >= m_generations.size()) continue;
             const EntityId id = MakeEntity(idx, m_generations[idx]);
-            fn(id, Pool<Ts>().Get(idx)...);
+            fn(id, FetchSlot<QueryComponent<Ts>>(TermPool<Ts>(pools), TermPool<Ts>(pools).Index(idx))...);
         }
     }
 
     // Each<T>(fn) — calls fn(EntityId, T&) for every entity that owns T.
     // Slightly cheaper than View<T> because there is no intersection test.
+    // T is a query term, as for View.
     template<typename T, typename Fn>
     void Each(Fn&& fn) {
-        auto* p = PoolPtr<T>();
+        Each<T>(CurrentTick(), std::forward<Fn>(fn));
+    }
+
+    template<typename T, typename Fn>
+    void Each(uint32_t since, Fn&& fn) {
+        auto* p = PoolPtr<QueryComponent<T>>();
         if (!p || p->Size() == 0) return;
-        const auto idxList = p->EntityIndices(); // snapshot
-        for (const uint32_t idx : idxList) {
-            if (idx >= m_generations.size()) continue;
-            const EntityId id = MakeEntity(idx, m_generations[idx]);
-            fn(id, p->Get(idx));
+        const auto& dense = p->EntityIndices();
+        for (size_t i = 0; i < dense.size(); ++i) {
+            if (!MatchesFilter<T>(*p, i, since)) continue;
+            const uint32_t idx = dense[i];
+            fn(MakeEntity(idx, m_generations[idx]), FetchSlot<QueryComponent<T>>(*p, i));
+        }
+    }
+
+    // ParallelView<Ts...>(jobs, grain, fn) — View<Ts...> split into chunks
+    // of `grain` dense slots that run concurrently on `jobs` (the calling
+    // thread helps). Blocks until every chunk has finished. Changed / Added
+    // terms match the current tick.
+    //
+    // grain is rounded up to whole cache lines of the first component type so
+    // neighbouring chunks do not write to the same line. fn runs on several
+    // threads at once — see "Thread safety" in the class comment.
+    template<typename... Ts, typename Fn>
+    void ParallelView(Jobs::JobPool& jobs, size_t grain, Fn&& fn) {
+        static_assert(sizeof...(Ts) > 0, "ParallelView requires at least one component type");
+
+        IPool* smallest = FindSmallestPool<QueryComponent<Ts>...>();
+        if (!smallest || smallest->Size() == 0) return;
+
+        const auto     pools = std::make_tuple(PoolPtr<QueryComponent<Ts>>()...);
+        const uint32_t since = CurrentTick();
+        grain = CacheLineGrain<QueryComponent<std::tuple_element_t<0, std::tuple<Ts...>>>>(grain);
+
+        if (const IGroup* group = OwningGroupOf<QueryComponent<Ts>...>()) {
+            const auto& dense = std::get<0>(pools)->EntityIndices();
+            jobs.ParallelFor(group->Size(), grain, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    if (!(MatchesFilter<Ts>(TermPool<Ts>(pools), i, since) && ...)) continue;
+                    const uint32_t idx = dense[i];
+                    fn(MakeEntity(idx, m_generations[idx]),
+                       FetchSlot<QueryComponent<Ts>>(TermPool<Ts>(pools), i)...);
+                }
+            });
+            return;
+        }
+
+        const ComponentMask& required = MaskOf<QueryComponent<Ts>...>();
+        const auto&          dense    = smallest->EntityIndices();
+        jobs.ParallelFor(dense.size(), grain, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const uint32_t idx = dense[i];
+                if ((m_masks[idx] & required) != required) continue;
+                if (!(MatchesFilter<Ts>(TermPool<Ts>(pools), TermPool<Ts>(pools).Index(idx), since) && ...))
+                    continue;
+                fn(MakeEntity(idx, m_generations[idx]),
+                   FetchSlot<QueryComponent<Ts>>(TermPool<Ts>(pools), TermPool<Ts>(pools).Index(idx))...);
+            }
+        });
+    }
+
+    // As above, on the process-wide Jobs::JobPool::Shared() pool.
+    template<typename... Ts, typename Fn>
+    void ParallelView(size_t grain, Fn&& fn) {
+        ParallelView<Ts...>(Jobs::JobPool::Shared(), grain, std::forward<Fn>(fn));
+    }
+
+    // ParallelEach<T>(jobs, grain, fn) — Each<T> split into chunks of the
+    // dense array that run concurrently. Same rules as ParallelView.
+    template<typename T, typename Fn>
+    void ParallelEach(Jobs::JobPool& jobs, size_t grain, Fn&& fn) {
+        auto* p = PoolPtr<QueryComponent<T>>();
+        if (!p || p->Size() == 0) return;
+        const auto&    dense = p->EntityIndices();
+        const uint32_t since = CurrentTick();
+        jobs.ParallelFor(dense.size(), CacheLineGrain<QueryComponent<T>>(grain), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (!MatchesFilter<T>(*p, i, since)) continue;
+                const uint32_t idx = dense[i];
+                fn(MakeEntity(idx, m_generations[idx]), FetchSlot<QueryComponent<T>>(*p, i));
+            }
+        });
+    }
+
+    template<typename T, typename Fn>
+    void ParallelEach(size_t grain, Fn&& fn) {
+        ParallelEach<T>(Jobs::JobPool::Shared(), grain, std::forward<Fn>(fn));
+    }
+
+    // Group<Ts...>() — declare (or fetch) an owning group over Ts.
+    //
+    // The group takes ownership of the pools of every T in Ts and keeps the
+    // entities that own ALL of them packed at the front of each pool, in the
+    // same order. View<Ts...> over exactly the grouped types then becomes a
+    // linear walk over parallel arrays, and the returned GroupView can be
+    // iterated directly.
+    //
+    // Each pool can be owned by at most one group. Groups are maintained by
+    // AddComponent / RemoveComponent / DestroyEntity; emplacing straight into
+    // a pool obtained from Pool<T>() bypasses them.
+    template<typename... Ts>
+    GroupView<Ts...> Group() {
+        static_assert(sizeof...(Ts) > 1, "Group requires at least two component types");
+
+        if (const IGroup* existing = OwningGroupOf<Ts...>())
+            return GroupView<Ts...>(*existing, m_generations, Pool<Ts>()...);
+
+        assert(((Pool<Ts>().Owner() == nullptr) && ...)
+               && "Registry::Group — a component pool is already owned by another group");
+
+        auto  group = std::make_unique<OwningGroup<Ts...>>(Pool<Ts>()...);
+        auto* raw   = group.get();
+        (Pool<Ts>().SetOwner(raw), ...);
+        m_groups.push_back(std::move(group));
+
+        // Pack the entities that already own every T.
+        IPool* smallest = FindSmallestPool<Ts...>();
+        const auto idxList = smallest->EntityIndices(); // snapshot; OnAdd reorders
+        for (const uint32_t idx : idxList) raw->OnAdd(idx);
+
+        return GroupView<Ts...>(*raw, m_generations, Pool<Ts>()...);
+    }
+
+    // -----------------------------------------------------------------------
+    // Component observers
+    // -----------------------------------------------------------------------
+    //
+    //   reg.OnConstruct<ColliderSphereComponent>(
+    //       [&](Registry& r, std::span<const EntityId> ids) {
+    //           for (EntityId id : ids) physics.Register(id, r.GetComponent<...>(id));
+    //       });
+    //   ...
+    //   reg.DispatchEvents();   // once per frame, at a sync point
+    //
+    // Adding or removing an observed component only appends the EntityId to
+    // a per-type log (one null-pointer test for unobserved types — no call,
+    // no allocation). DispatchEvents hands each log to the observers as one
+    // span:
+    //
+    //   • destroy batches first, then construct batches, per type;
+    //   • a construct batch lists only entities that still own the
+    //     component, so observers may read it; destroy batches list ids that
+    //     may already be dead (the component is gone either way);
+    //   • events raised by observers are dispatched in the same call.
+    //
+    // Clear and Deserialize drop pending events and raise none: Deserialize
+    // restores components straight into the pools (RestoreComponents), not
+    // through AddComponent, so a loaded world starts with empty logs.
+
+    using ObserverId        = uint32_t;
+    using ComponentObserver = std::function<void(Registry&, std::span<const EntityId>)>;
+
+    // Call fn with every entity that gained a T since the last dispatch.
+    template<typename T>
+    ObserverId OnConstruct(ComponentObserver fn) {
+        return Observe(ComponentTypeOf<T>(), Pool<T>(), std::move(fn), true);
+    }
+
+    // Call fn with every entity that lost its T (removed or destroyed) since
+    // the last dispatch.
+    template<typename T>
+    ObserverId OnDestroy(ComponentObserver fn) {
+        return Observe(ComponentTypeOf<T>(), Pool<T>(), std::move(fn), false);
+    }
+
+    // Remove an observer; unknown ids are ignored. The event log of a type
+    // stays attached (and keeps filling) until its last observer is gone.
+    void Disconnect(ObserverId id) {
+        for (size_t type = 0; type < m_observers.size(); ++type) {
+            auto& obs = m_observers[type];
+            if (!obs) continue;
+            auto match = [id](const auto& entry) { return entry.first == id; };
+            std::erase_if(obs->onConstruct, match);
+            std::erase_if(obs->onDestroy,   match);
+            if (obs->onConstruct.empty() && obs->onDestroy.empty()) {
+                if (type < m_pools.size() && m_pools[type]) m_pools[type]->SetEvents(nullptr);
+                obs.reset();
+            }
+        }
+    }
+
+    // Deliver every buffered construct / destroy event. Call at a sync
+    // point — not from inside View / Each.
+    void DispatchEvents() {
+        for (bool pending = true; pending; ) {
+            pending = false;
+            for (size_t type = 0; type < m_observers.size(); ++type) {
+                ComponentObservers* obs = m_observers[type].get();
+                if (!obs) continue;
+                if (obs->events.destroyed.empty() && obs->events.constructed.empty()) continue;
+                pending = true;
+
+                // Swap the logs out: observers may raise new events (and even
+                // disconnect themselves) while the batch is being delivered.
+                std::swap(m_destroyBatch,   obs->events.destroyed);
+                std::swap(m_constructBatch, obs->events.constructed);
+                std::erase_if(m_constructBatch, [&](EntityId id) {
+                    return !IsAlive(id) || !m_masks[EntityIndex(id)].test(static_cast<ComponentTypeId>(type));
+                });
+
+                const auto destroyFns   = obs->onDestroy;
+                const auto constructFns = obs->onConstruct;
+                if (!m_destroyBatch.empty())
+                    for (const auto& [oid, fn] : destroyFns) fn(*this, m_destroyBatch);
+                if (!m_constructBatch.empty())
+                    for (const auto& [oid, fn] : constructFns) fn(*this, m_constructBatch);
+                m_destroyBatch.clear();
+                m_constructBatch.clear();
+            }
         }
     }
 
+    // -----------------------------------------------------------------------
+    // Tag index — defined in Tags.hpp (include it, or ECS.hpp, to use)
+    // -----------------------------------------------------------------------
+
+    // Give entity id the TagComponent name (adding or replacing it) and
+    // index it under that name.
+    void SetTag(EntityId id, std::string_view name);
+
+    // A live entity tagged name, or INVALID_ENTITY. O(1) on average; when
+    // several entities share the name, which one is returned is unspecified.
+    [[nodiscard]] EntityId FindByTag(std::string_view name) const;
+
+    // Append every live entity tagged name to out; returns how many.
+    size_t FindAllByTag(std::string_view name, std::vector<EntityId>& out) const;
+
+    // Every live entity tagged name, read in place from the index (no copy).
+    // Valid until the next tag change or entity destruction.
+    [[nodiscard]] std::span<const EntityId> Tagged(std::string_view name) const;
+
+    // Re-index every TagComponent. Needed only after TagComponent::name was
+    // assigned directly (rename through SetTag instead) — FindByTag keeps
+    // reporting the old name until then.
+    void RebuildTagIndex();
+
+    // -----------------------------------------------------------------------
+    // Prefabs — defined in Prefab.hpp (include it, or ECS.hpp, to use)
+    // -----------------------------------------------------------------------
+
+    // Create out.size() entities, each with a copy of every component in
+    // prefab, writing their ids into out. Each pool is reserved once and
+    // appended to in one pass.
+    void Instantiate(const Prefab& prefab, std::span<EntityId> out);
+    [[nodiscard]] std::vector<EntityId> Instantiate(const Prefab& prefab, size_t count);
+
+    // -----------------------------------------------------------------------
+    // Snapshots — defined in Snapshot.hpp (include it, or ECS.hpp, to use)
+    // -----------------------------------------------------------------------
+
+    // Binary snapshot of the entity table and every pool named in schema.
+    [[nodiscard]] std::vector<std::byte> Serialize(const SnapshotSchema& schema) const;
+
+    // Replace the whole Registry with a snapshot made by Serialize. data may
+    // point straight into a memory-mapped file. Returns false — leaving the
+    // Registry empty — if data is truncated, corrupt or from an incompatible
+    // build.
+    bool Deserialize(const SnapshotSchema& schema, std::span<const std::byte> data);
+
     // -----------------------------------------------------------------------
     // Direct pool access (advanced / systems use)
     // -----------------------------------------------------------------------
 
-    // Returns the typed ComponentPool<T>, creating it if it does not exist yet.
+    // Returns the typed pool for T (PoolOf<T>), creating it if it does not exist yet.
+    // Add / remove components through the Registry, not the pool: entity
+    // signatures and owning groups are only kept in sync there.
     template<typename T>
-    [[nodiscard]] ComponentPool<T>& Pool() {
-        const auto key = std::type_index(typeid(T));
-        auto it = m_pools.find(key);
-        if (it == m_pools.end()) {
-            auto pool = std::make_unique<ComponentPool<T>>();
-            auto* raw = pool.get();
-            m_pools.emplace(key, std::move(pool));
-            return *raw;
+    [[nodiscard]] PoolOf<T>& Pool() {
+        const ComponentTypeId type = ComponentTypeOf<T>();
+        if (type >= m_pools.size()) m_pools.resize(type + 1);
+        auto& slot = m_pools[type];
+        if (!slot) {
+            auto pool = std::make_unique<PoolOf<T>>();
+            pool->SetClock(m_clock.get());
+            slot = std::move(pool);
         }
-        return *static_cast<ComponentPool<T>*>(it->second.get());
+        return *static_cast<PoolOf<T>*>(slot.get());
     }
 
     template<typename T>
-    [[nodiscard]] ComponentPool<T>* PoolPtr() {
-        const auto key = std::type_index(typeid(T));
-        const auto it  = m_pools.find(key);
-        return it != m_pools.end()
-            ? static_cast<ComponentPool<T>*>(it->second.get())
+    [[nodiscard]] PoolOf<T>* PoolPtr() {
+        const ComponentTypeId type = ComponentTypeOf<T>();
+        return type < m_pools.size()
+            ? static_cast<PoolOf<T>*>(m_pools[type].get())
             : nullptr;
     }
 
+    // Type-erased pool for component type id `type`, or nullptr.
+    [[nodiscard]] const IPool* PoolById(ComponentTypeId type) const noexcept {
+        return type < m_pools.size() ? m_pools[type].get() : nullptr;
+    }
+
     template<typename T>
-    [[nodiscard]] const ComponentPool<T>* PoolPtr() const {
-        const auto key = std::type_index(typeid(T));
-        const auto it  = m_pools.find(key);
-        return it != m_pools.end()
-            ? static_cast<const ComponentPool<T>*>(it->second.get())
+    [[nodiscard]] const PoolOf<T>* PoolPtr() const {
+        const ComponentTypeId type = ComponentTypeOf<T>();
+        return type < m_pools.size()
+            ? static_cast<const PoolOf<T>*>(m_pools[type].get())
             : nullptr;
     }
 
@@ -249,22 +690,103 @@ private:
     // ---- Internal helpers -------------------------------------------------
 
     template<typename T>
-    [[nodiscard]] const ComponentPool<T>& PoolConst() const {
+    [[nodiscard]] const PoolOf<T>& PoolConst() const {
         const auto* p = PoolPtr<T>();
         assert(p && "Registry — component pool does not exist");
         return *p;
     }
 
+    // Signature bits of the component types in Ts (built once per Ts).
+    template<typename... Ts>
+    [[nodiscard]] static const ComponentMask& MaskOf() {
+        static const ComponentMask s_mask = [] {
+            ComponentMask m;
+            (m.set(ComponentTypeOf<Ts>()), ...);
+            return m;
+        }();
+        return s_mask;
+    }
+
     // True if entity index idx has every component type in Ts.
     template<typename... Ts>
     [[nodiscard]] bool HasAllAt(uint32_t idx) const {
-        return (HasAt<Ts>(idx) && ...);
+        const ComponentMask& required = MaskOf<Ts...>();
+        return (m_masks[idx] & required) == required;
     }
 
+    // Round grain up to a whole number of 64-byte cache lines of T.
     template<typename T>
-    [[nodiscard]] bool HasAt(uint32_t idx) const {
-        const auto* p = PoolPtr<T>();
-        return p && p->Has(idx);
+    [[nodiscard]] static size_t CacheLineGrain(size_t grain) noexcept {
+        constexpr size_t kCacheLine    = 64;
+        constexpr size_t kPerLine      = sizeof(T) >= kCacheLine ? 1 : kCacheLine / sizeof(T);
+        grain = grain < 1 ? 1 : grain;
+        return (grain + kPerLine - 1) / kPerLine * kPerLine;
+    }
+
+    // Return entity slot idx (already stripped of components) to the free
+    // list: bump its generation and swap-remove it from the alive list.
+    void Release(uint32_t idx) {
+        UnindexTag(idx);
+        // Bump generation so the old EntityId becomes stale
+        m_generations[idx] = (m_generations[idx] + 1u) & GEN_MASK;
+        m_freeList.push(idx);
+
+        const uint32_t pos  = m_alivePos[idx];
+        const EntityId last = m_alive.back();
+        m_alive[pos]                   = last;
+        m_alivePos[EntityIndex(last)]  = pos;
+        m_alive.pop_back();
+    }
+
+    // Remove the component of live entity index idx from pool, keeping its
+    // owning group consistent and logging the destroy event if observed.
+    void RemoveAt(IPool& pool, uint32_t idx) {
+        if (pool.Owner()) pool.Owner()->OnRemove(idx);
+        if (ComponentEvents* events = pool.Events())
+            events->destroyed.push_back(MakeEntity(idx, m_generations[idx]));
+        pool.Remove(idx);
+    }
+
+    // Append ids to the tag index bucket for name / drop entity index idx
+    // from its bucket (no-op if it has none) — defined in Tags.hpp.
+    void IndexTag(std::string_view name, std::span<const EntityId> ids);
+    void UnindexTag(uint32_t idx);
+
+    // Snapshot load: give entity index indices[i] the T read(i), with one
+    // reserve and no per-component group or event bookkeeping (Deserialize
+    // packs groups once at the end) — defined in Snapshot.hpp.
+    friend class SnapshotSchema;
+    template<typename T, typename Read>
+    void RestoreComponents(std::span<const uint32_t> indices, Read&& read);
+
+    ObserverId Observe(ComponentTypeId type, IPool& pool, ComponentObserver fn, bool construct) {
+        if (type >= m_observers.size()) m_observers.resize(type + 1);
+        auto& obs = m_observers[type];
+        if (!obs) obs = std::make_unique<ComponentObservers>();
+        pool.SetEvents(&obs->events);
+        const ObserverId id = m_nextObserver++;
+        (construct ? obs->onConstruct : obs->onDestroy).emplace_back(id, std::move(fn));
+        return id;
+    }
+
+    // The owning group whose component set is exactly Ts (in any order),
+    // or nullptr.
+    template<typename... Ts>
+    [[nodiscard]] IGroup* OwningGroupOf() {
+        using First = std::tuple_element_t<0, std::tuple<Ts...>>;
+        auto* first = PoolPtr<First>();
+        if (!first || !first->Owner()) return nullptr;
+        IGroup* group = first->Owner();
+        // Every T owned by the same group and the group owns no other type.
+        if (group->TypeCount() != sizeof...(Ts)) return nullptr;
+        if (!((PoolPtr<Ts>() && PoolPtr<Ts>()->Owner() == group) && ...)) return nullptr;
+        return group;
+    }
+
+    // Pool of query term Q inside a tuple built from PoolPtr<QueryComponent<Ts>>()...
+    template<typename Q, typename Tuple>
+    [[nodiscard]] static PoolOf<QueryComponent<Q>>& TermPool(const Tuple& pools) noexcept {
+        return *std::get<PoolOf<QueryComponent<Q>>*>(pools);
     }
 
     // Return the pool (among those for Ts) with the fewest live components.
@@ -283,12 +805,56 @@ private:
 
     // ---- Storage ----------------------------------------------------------
 
-    std::vector<EntityId>  m_alive;       // all live EntityIds
-    std::vector<uint32_t>  m_generations; // generations[entityIndex]
-    std::queue<uint32_t>   m_freeList;    // recycled entity indices
-
-    // One pool per component type, keyed by std::type_index.
-    std::unordered_map<std::type_index, std::unique_ptr<IPool>> m_pools;
+    std::vector<EntityId>      m_alive;       // all live EntityIds
+    std::vector<uint32_t>      m_alivePos;    // alivePos[entityIndex] → position in m_alive
+    std::vector<uint32_t>      m_generations; // generations[entityIndex]
+    std::vector<ComponentMask> m_masks;       // masks[entityIndex] → owned component types
+    std::queue<uint32_t>       m_freeList;    // recycled entity indices
+
+    // One pool per component type, indexed by ComponentTypeOf<T>().
+    // Slots for types this Registry has never seen are nullptr.
+    std::vector<std::unique_ptr<IPool>> m_pools;
+
+    // Owning groups declared with Group<Ts...>(); each owns its pools.
+    std::vector<std::unique_ptr<IGroup>> m_groups;
+
+    // Observers and event logs per component type, indexed like m_pools;
+    // nullptr for types nobody observes. Heap-allocated so the pools'
+    // Events() pointers survive moving the Registry.
+    struct ComponentObservers {
+        ComponentEvents                                     events;
+        std::vector<std::pair<ObserverId, ComponentObserver>> onConstruct;
+        std::vector<std::pair<ObserverId, ComponentObserver>> onDestroy;
+    };
+    std::vector<std::unique_ptr<ComponentObservers>> m_observers;
+    ObserverId                                       m_nextObserver = 1;
+    std::vector<EntityId>                            m_constructBatch; // DispatchEvents scratch
+    std::vector<EntityId>                            m_destroyBatch;
+
+    // Tag index: interned name → the live entities tagged with it, kept
+    // exact by AddComponent / RemoveComponent<TagComponent>, SetTag,
+    // Instantiate and entity release. m_tagSlots[entityIndex] records the
+    // bucket and position of each indexed entity so removal is a swap-and-pop;
+    // empty buckets are erased. Buckets live in the map's nodes, so the slot
+    // pointers survive rehashing and moving the Registry.
+    struct TagBucket {
+        std::vector<EntityId> ids;
+        const std::string*    name = nullptr; // this bucket's key
+    };
+    struct TagSlot {
+        TagBucket* bucket = nullptr;          // nullptr: not indexed
+        uint32_t   pos    = 0;                // position in bucket->ids
+    };
+    struct TagHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+    };
+    std::unordered_map<std::string, TagBucket, TagHash, std::equal_to<>> m_tagIndex;
+    std::vector<TagSlot>                                                 m_tagSlots;
+
+    // Change-tracking tick read by every pool. Heap-allocated so its address
+    // survives moving the Registry.
+    std::unique_ptr<ChangeClock> m_clock = std::make_unique<ChangeClock>();
 };
 
 } // namespace Hotones::ECS
@@ -0,0 +1,519 @@
+#pragma once
+
+#include <ECS/Entity.hpp>
+#include <ECS/Registry.hpp>
+#include <ECS/Components.hpp>
+#include <ECS/KinematicPool.hpp>
+#include <ECS/Tags.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// Snapshot.hpp — binary Registry snapshot / restore.
+//
+//   SnapshotSchema schema = SnapshotSchema::Builtin();
+//   schema.Add<MyComponent>("MyComponent");          // trivially copyable
+//
+//   std::vector<std::byte> bytes = reg.Serialize(schema);
+//   ...
+//   if (!reg.Deserialize(schema, bytes)) { /* corrupt / incompatible */ }
+//
+// What is saved
+// -------------
+//   • The entity table: every slot's generation, the live ids in order and
+//     the free list in order — restored ids (and ids recycled afterwards)
+//     match the saved Registry exactly.
+//   • One section per schema type with a pool: the owning entity indices
+//     followed by the components. Trivially copyable types are written as a
+//     raw blob in dense order; types with strings use a codec that writes a
+//     record per component plus a string-table section.
+//
+// Component type ids depend on first-use order, so sections are keyed by
+// the name given to SnapshotSchema::Add, not by ComponentTypeId. Sections
+// whose name the schema does not know are skipped on load.
+//
+// Layout
+// ------
+//   Every array starts on a 16-byte boundary, and Deserialize reads straight
+//   from the span it is given, so a memory-mapped snapshot file can be
+//   restored in place without reading it into a buffer first. The format is
+//   native-endian; a snapshot from a different byte order is rejected.
+// ---------------------------------------------------------------------------
+
+// Appends one component record to a string-bearing section.
+class SnapshotWriter {
+public:
+    SnapshotWriter(std::vector<std::byte>& records, std::string& strings) noexcept
+        : m_records(&records), m_strings(&strings) {}
+
+    template<typename T>
+    void Pod(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "SnapshotWriter::Pod — T must be trivially copyable");
+        const auto* p = reinterpret_cast<const std::byte*>(&value);
+        m_records->insert(m_records->end(), p, p + sizeof(T));
+    }
+
+    // Stored in the section's string table; the record holds offset + length.
+    void String(std::string_view s) {
+        Pod(static_cast<uint32_t>(m_strings->size()));
+        Pod(static_cast<uint32_t>(s.size()));
+        m_strings->append(s);
+    }
+
+private:
+    std::vector<std::byte>* m_records;
+    std::string*            m_strings;
+};
+
+// Reads back what a SnapshotWriter wrote. Every read returns false (and
+// leaves the value untouched) once the data runs out or is inconsistent.
+class SnapshotReader {
+public:
+    SnapshotReader(std::span<const std::byte> records, std::string_view strings) noexcept
+        : m_records(records), m_strings(strings) {}
+
+    template<typename T>
+    bool Pod(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "SnapshotReader::Pod — T must be trivially copyable");
+        if (m_records.size() - m_pos < sizeof(T)) return false;
+        std::memcpy(&value, m_records.data() + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return true;
+    }
+
+    bool String(std::string& s) {
+        uint32_t offset = 0, length = 0;
+        if (!Pod(offset) || !Pod(length)) return false;
+        if (offset > m_strings.size() || length > m_strings.size() - offset) return false;
+        s.assign(m_strings.substr(offset, length));
+        return true;
+    }
+
+private:
+    std::span<const std::byte> m_records;
+    std::string_view           m_strings;
+    size_t                     m_pos = 0;
+};
+
+// ---------------------------------------------------------------------------
+// SnapshotSchema — the component types a snapshot stores, by name.
+// ---------------------------------------------------------------------------
+class SnapshotSchema {
+public:
+    static constexpr size_t MAX_NAME = 31; // section names are stored in 32 bytes
+
+    // Store T as a raw blob (memcpy). T must be trivially copyable and must
+    // not hold pointers or process-local handles you expect to survive.
+    template<typename T>
+    SnapshotSchema& Add(std::string name) {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "SnapshotSchema::Add — use the codec overload for non-trivially-copyable types");
+        Entry e;
+        e.name     = std::move(name);
+        e.kind     = Kind::Raw;
+        e.elemSize = sizeof(T);
+        e.save = [](const Registry& reg, std::vector<uint32_t>& indices,
+                    std::vector<std::byte>& records, std::string&) {
+            const auto* pool = reg.PoolPtr<T>();
+            if (!pool) return;
+            indices = pool->EntityIndices();
+            records.resize(indices.size() * sizeof(T));
+            const auto& data = pool->Components();
+            for (size_t i = 0; i < indices.size(); ++i) {
+                const T value = data[i];
+                std::memcpy(records.data() + i * sizeof(T), &value, sizeof(T));
+            }
+        };
+        e.load = [](Registry& reg, std::span<const uint32_t> indices,
+                    std::span<const std::byte> records, std::string_view) {
+            if (records.size() != indices.size() * sizeof(T)) return false;
+            reg.RestoreComponents<T>(indices, [&](size_t i) {
+                T value;
+                std::memcpy(&value, records.data() + i * sizeof(T), sizeof(T));
+                return value;
+            });
+            return true;
+        };
+        return Insert(std::move(e));
+    }
+
+    // Store T through a codec: write(component, writer) emits one record,
+    // read(reader, component) parses it back (returns false on bad data).
+    template<typename T>
+    SnapshotSchema& Add(std::string name,
+                        void (*write)(const T&, SnapshotWriter&),
+                        bool (*read)(SnapshotReader&, T&)) {
+        Entry e;
+        e.name     = std::move(name);
+        e.kind     = Kind::Records;
+        e.elemSize = 0;
+        e.save = [write](const Registry& reg, std::vector<uint32_t>& indices,
+                         std::vector<std::byte>& records, std::string& strings) {
+            const auto* pool = reg.PoolPtr<T>();
+            if (!pool) return;
+            indices = pool->EntityIndices();
+            SnapshotWriter writer(records, strings);
+            const auto& data = pool->Components();
+            for (size_t i = 0; i < indices.size(); ++i) write(data[i], writer);
+        };
+        e.load = [read](Registry& reg, std::span<const uint32_t> indices,
+                        std::span<const std::byte> records, std::string_view strings) {
+            SnapshotReader reader(records, strings);
+            std::vector<T> values(indices.size());
+            for (T& value : values)
+                if (!read(reader, value)) return false;
+            reg.RestoreComponents<T>(indices, [&](size_t i) { return std::move(values[i]); });
+            return true;
+        };
+        return Insert(std::move(e));
+    }
+
+    // Every built-in component that can outlive the process: spatial,
+    // gameplay, tag, script and audio state. RenderModel, Billboard and
+    // Player are left out (GPU resources / engine pointers); ScriptComponent
+    // comes back with luaRef = -1 and ColliderSphereComponent keeps its
+    // physicsHandle value, which is only meaningful if the same static
+    // meshes are registered again in the same order.
+    [[nodiscard]] static SnapshotSchema Builtin() {
+        SnapshotSchema s;
+        s.Add<TransformComponent>     ("Transform");
+        s.Add<VelocityComponent>      ("Velocity");
+        s.Add<ColliderSphereComponent>("ColliderSphere");
+        s.Add<GroupComponent>         ("Group");
+        s.Add<HealthComponent>        ("Health");
+        s.Add<LifetimeComponent>      ("Lifetime");
+        s.Add<NetworkComponent>       ("Network");
+        s.Add<KinematicComponent>     ("Kinematic");
+        s.Add<ParentComponent>        ("Parent");
+        // Saved so TransformHierarchySystem, which only updates entities
+        // that already own one (SetParent adds it), still covers restored
+        // hierarchies.
+        s.Add<WorldTransformComponent>("WorldTransform");
+
+        s.Add<ChildrenComponent>("Children",
+            [](const ChildrenComponent& c, SnapshotWriter& w) {
+                w.Pod(static_cast<uint32_t>(c.children.size()));
+                for (const EntityId child : c.children) w.Pod(child);
+            },
+            [](SnapshotReader& r, ChildrenComponent& c) {
+                uint32_t count = 0;
+                if (!r.Pod(count)) return false;
+                for (uint32_t i = 0; i < count; ++i) {
+                    EntityId child = INVALID_ENTITY;
+                    if (!r.Pod(child)) return false;
+                    c.children.push_back(child);
+                }
+                return true;
+            });
+
+        s.Add<TagComponent>("Tag",
+            [](const TagComponent& c, SnapshotWriter& w) { w.String(c.name); },
+            [](SnapshotReader& r, TagComponent& c) { return r.String(c.name); });
+
+        s.Add<ScriptComponent>("Script",
+            [](const ScriptComponent& c, SnapshotWriter& w) {
+                w.String(c.className);
+                w.Pod(static_cast<uint8_t>(c.active));
+            },
+            [](SnapshotReader& r, ScriptComponent& c) {
+                uint8_t active = 0;
+                if (!r.String(c.className) || !r.Pod(active)) return false;
+                c.active = active != 0;
+                c.luaRef = -1; // Lua registry refs do not survive the process
+                return true;
+            });
+
+        s.Add<AudioEmitterComponent>("AudioEmitter",
+            [](const AudioEmitterComponent& c, SnapshotWriter& w) {
+                w.String(c.soundKey);
+                w.Pod(c.volume); w.Pod(c.pitch); w.Pod(c.maxDist);
+                w.Pod(static_cast<uint8_t>(c.loop));
+                w.Pod(static_cast<uint8_t>(c.playing));
+                w.Pod(static_cast<uint8_t>(c.autoPlay));
+            },
+            [](SnapshotReader& r, AudioEmitterComponent& c) {
+                uint8_t loop = 0, playing = 0, autoPlay = 0;
+                if (!r.String(c.soundKey) || !r.Pod(c.volume) || !r.Pod(c.pitch) || !r.Pod(c.maxDist)
+                    || !r.Pod(loop) || !r.Pod(playing) || !r.Pod(autoPlay)) return false;
+                c.loop = loop != 0; c.playing = playing != 0; c.autoPlay = autoPlay != 0;
+                return true;
+            });
+        return s;
+    }
+
+private:
+    friend class Registry;
+
+    enum class Kind : uint32_t { Raw = 1, Records = 2 };
+
+    using SaveFn = std::function<void(const Registry&, std::vector<uint32_t>&,
+                                      std::vector<std::byte>&, std::string&)>;
+    using LoadFn = std::function<bool(Registry&, std::span<const uint32_t>,
+                                      std::span<const std::byte>, std::string_view)>;
+
+    struct Entry {
+        std::string name;
+        Kind        kind     = Kind::Raw;
+        uint32_t    elemSize = 0;   // sizeof(T) for Raw
+        SaveFn      save;
+        LoadFn      load;
+    };
+
+    SnapshotSchema& Insert(Entry e) {
+        assert(!e.name.empty() && e.name.size() <= MAX_NAME && "SnapshotSchema::Add — name must be 1..31 chars");
+        assert(!Find(e.name) && "SnapshotSchema::Add — duplicate name");
+        m_entries.push_back(std::move(e));
+        return *this;
+    }
+
+    [[nodiscard]] const Entry* Find(std::string_view name) const {
+        for (const auto& e : m_entries)
+            if (e.name == name) return &e;
+        return nullptr;
+    }
+
+    std::vector<Entry> m_entries;
+};
+
+namespace Detail {
+
+inline constexpr char     SNAPSHOT_MAGIC[4]   = { 'H', 'S', 'N', 'P' };
+inline constexpr uint32_t SNAPSHOT_VERSION    = 1;
+inline constexpr uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304u;
+inline constexpr size_t   SNAPSHOT_ALIGN      = 16;
+
+struct SnapshotHeader {
+    char     magic[4];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t slotCount;     // entity slots (generations[])
+    uint32_t aliveCount;    // live ids, in Registry::Entities() order
+    uint32_t freeCount;     // free list, front first
+    uint32_t sectionCount;
+    uint32_t tick;          // change-tracking tick
+};
+
+struct SnapshotSection {
+    char     name[32];
+    uint32_t kind;          // SnapshotSchema::Kind
+    uint32_t count;         // components in the section
+    uint32_t elemSize;      // sizeof(T) for raw sections, else 0
+    uint32_t recordBytes;
+    uint32_t stringBytes;
+    uint32_t reserved[3];
+};
+
+static_assert(sizeof(SnapshotHeader)  % SNAPSHOT_ALIGN == 0);
+static_assert(sizeof(SnapshotSection) % SNAPSHOT_ALIGN == 0);
+
+inline void PutBytes(std::vector<std::byte>& out, const void* p, size_t n) {
+    const auto* b = static_cast<const std::byte*>(p);
+    out.insert(out.end(), b, b + n);
+    out.resize((out.size() + SNAPSHOT_ALIGN - 1) / SNAPSHOT_ALIGN * SNAPSHOT_ALIGN, std::byte{ 0 });
+}
+
+// Bounds-checked cursor over the input span.
+class SnapshotCursor {
+public:
+    explicit SnapshotCursor(std::span<const std::byte> data) noexcept : m_data(data) {}
+
+    // Next n bytes (then skip to the next 16-byte boundary), or nullptr.
+    [[nodiscard]] const std::byte* Take(size_t n) noexcept {
+        const size_t padded = (n + SNAPSHOT_ALIGN - 1) / SNAPSHOT_ALIGN * SNAPSHOT_ALIGN;
+        if (m_data.size() - m_pos < padded) return nullptr;
+        const std::byte* p = m_data.data() + m_pos;
+        m_pos += padded;
+        return p;
+    }
+
+    template<typename T>
+    [[nodiscard]] bool Read(T& value) noexcept {
+        const std::byte* p = Take(sizeof(T));
+        if (!p) return false;
+        std::memcpy(&value, p, sizeof(T));
+        return true;
+    }
+
+    // count uint32 values (copied out: the span may not be 4-aligned).
+    [[nodiscard]] bool ReadU32(size_t count, std::vector<uint32_t>& out) {
+        if (count > m_data.size() / sizeof(uint32_t)) return false;
+        const std::byte* p = Take(count * sizeof(uint32_t));
+        if (!p) return false;
+        out.resize(count);
+        if (count) std::memcpy(out.data(), p, count * sizeof(uint32_t));
+        return true;
+    }
+
+private:
+    std::span<const std::byte> m_data;
+    size_t                     m_pos = 0;
+};
+
+} // namespace Detail
+
+// ---- Registry::Serialize / Deserialize ------------------------------------
+
+inline std::vector<std::byte> Registry::Serialize(const SnapshotSchema& schema) const {
+    using namespace Detail;
+
+    struct Section {
+        const SnapshotSchema::Entry* entry;
+        std::vector<uint32_t>        indices;
+        std::vector<std::byte>       records;
+        std::string                  strings;
+    };
+    std::vector<Section> sections;
+    for (const auto& e : schema.m_entries) {
+        Section s{ &e, {}, {}, {} };
+        e.save(*this, s.indices, s.records, s.strings);
+        if (!s.indices.empty()) sections.push_back(std::move(s));
+    }
+
+    std::vector<uint32_t> freeList;
+    freeList.reserve(m_freeList.size());
+    for (auto q = m_freeList; !q.empty(); q.pop()) freeList.push_back(q.front());
+
+    SnapshotHeader header{};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version      = SNAPSHOT_VERSION;
+    header.byteOrder    = SNAPSHOT_BYTE_ORDER;
+    header.slotCount    = static_cast<uint32_t>(m_generations.size());
+    header.aliveCount   = static_cast<uint32_t>(m_alive.size());
+    header.freeCount    = static_cast<uint32_t>(freeList.size());
+    header.sectionCount = static_cast<uint32_t>(sections.size());
+    header.tick         = m_clock->tick;
+
+    std::vector<std::byte> out;
+    PutBytes(out, &header, sizeof(header));
+    PutBytes(out, m_generations.data(), m_generations.size() * sizeof(uint32_t));
+    PutBytes(out, m_alive.data(),       m_alive.size()       * sizeof(EntityId));
+    PutBytes(out, freeList.data(),      freeList.size()      * sizeof(uint32_t));
+
+    for (const auto& s : sections) {
+        SnapshotSection sh{};
+        std::memcpy(sh.name, s.entry->name.data(), s.entry->name.size());
+        sh.kind        = static_cast<uint32_t>(s.entry->kind);
+        sh.count       = static_cast<uint32_t>(s.indices.size());
+        sh.elemSize    = s.entry->elemSize;
+        sh.recordBytes = static_cast<uint32_t>(s.records.size());
+        sh.stringBytes = static_cast<uint32_t>(s.strings.size());
+        PutBytes(out, &sh, sizeof(sh));
+        PutBytes(out, s.indices.data(), s.indices.size() * sizeof(uint32_t));
+        PutBytes(out, s.records.data(), s.records.size());
+        PutBytes(out, s.strings.data(), s.strings.size());
+    }
+    return out;
+}
+
+inline bool Registry::Deserialize(const SnapshotSchema& schema, std::span<const std::byte> data) {
+    using namespace Detail;
+
+    Clear();
+    SnapshotCursor in(data);
+
+    SnapshotHeader header{};
+    if (!in.Read(header)) return false;
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0
+        || header.version != SNAPSHOT_VERSION || header.byteOrder != SNAPSHOT_BYTE_ORDER
+        || header.slotCount > INDEX_MASK + 1u
+        || header.aliveCount + uint64_t(header.freeCount) != header.slotCount) return false;
+
+    // ---- Entity table -------------------------------------------------------
+    std::vector<uint32_t> alive, freeList;
+    if (!in.ReadU32(header.slotCount, m_generations) || !in.ReadU32(header.aliveCount, alive)
+        || !in.ReadU32(header.freeCount, freeList)) {
+        Clear();
+        return false;
+    }
+
+    // Every slot must be either alive or free, exactly once.
+    enum : uint8_t { UNSEEN, ALIVE, FREE };
+    std::vector<uint8_t> state(header.slotCount, UNSEEN);
+
+    m_masks.assign(header.slotCount, ComponentMask{});
+    m_alivePos.assign(header.slotCount, 0u);
+    m_alive.reserve(alive.size());
+    for (const EntityId id : alive) {
+        const uint32_t idx = EntityIndex(id);
+        if (idx >= header.slotCount || state[idx] != UNSEEN || EntityGeneration(id) != m_generations[idx]) {
+            Clear();
+            return false;
+        }
+        state[idx]      = ALIVE;
+        m_alivePos[idx] = static_cast<uint32_t>(m_alive.size());
+        m_alive.push_back(id);
+    }
+    for (const uint32_t idx : freeList) {
+        if (idx >= header.slotCount || state[idx] != UNSEEN) { Clear(); return false; }
+        state[idx] = FREE;
+        m_freeList.push(idx);
+    }
+    m_clock->tick = header.tick;
+
+    // ---- Component sections -------------------------------------------------
+    std::vector<uint32_t> indices;
+    std::vector<uint32_t> owner(header.slotCount, ~0u); // last section that listed a slot
+    std::vector<const SnapshotSchema::Entry*> loaded;    // one section per type
+    for (uint32_t s = 0; s < header.sectionCount; ++s) {
+        SnapshotSection sh{};
+        if (!in.Read(sh) || !in.ReadU32(sh.count, indices)) { Clear(); return false; }
+        const std::byte* records = in.Take(sh.recordBytes);
+        const std::byte* strings = in.Take(sh.stringBytes);
+        if (!records || !strings) { Clear(); return false; }
+
+        const std::string_view name(sh.name, static_cast<size_t>(
+            std::find(sh.name, sh.name + sizeof(sh.name), '\0') - sh.name));
+        const auto* entry = schema.Find(name);
+        if (!entry) continue; // type unknown to this schema: skip the section
+        if (static_cast<uint32_t>(entry->kind) != sh.kind || entry->elemSize != sh.elemSize
+            || std::find(loaded.begin(), loaded.end(), entry) != loaded.end()) {
+            Clear();
+            return false;
+        }
+        loaded.push_back(entry);
+        // Only live entities, each at most once per section.
+        for (const uint32_t idx : indices) {
+            if (idx >= header.slotCount || state[idx] != ALIVE || owner[idx] == s) {
+                Clear();
+                return false;
+            }
+            owner[idx] = s;
+        }
+        const bool ok = entry->load(*this, indices,
+            std::span<const std::byte>(records, sh.recordBytes),
+            std::string_view(reinterpret_cast<const char*>(strings), sh.stringBytes));
+        if (!ok) { Clear(); return false; }
+    }
+
+    // Pack owning groups once, now that every component is in place.
+    for (auto& group : m_groups)
+        for (const EntityId id : m_alive) group->OnAdd(EntityIndex(id));
+    RebuildTagIndex();
+    return true;
+}
+
+template<typename T, typename Read>
+inline void Registry::RestoreComponents(std::span<const uint32_t> indices, Read&& read) {
+    auto& pool = Pool<T>();
+    pool.Reserve(pool.Size() + indices.size());
+    const ComponentTypeId type = ComponentTypeOf<T>();
+    for (size_t i = 0; i < indices.size(); ++i) {
+        pool.Emplace(indices[i], read(i));
+        m_masks[indices[i]].set(type);
+    }
+}
+
+} // namespace Hotones::ECS
@@ -1,8 +1,11 @@
 #pragma once
 
-namespace Hotones::ECS {
+#include <ECS/ComponentType.hpp>
+#include <ECS/Registry.hpp>
+
+#include <vector>
 
-class Registry;
+namespace Hotones::ECS {
 
 // ---------------------------------------------------------------------------
 // System — base class for all ECS systems.
@@ -26,8 +29,20 @@ class Registry;
 //
 // Recommended ownership
 // ---------------------
-//   Store systems in a SystemManager or std::vector<std::unique_ptr<System>>
-//   and call Update on each one per frame from the scene's Update() method.
+//   Hand systems to a SystemScheduler and call its Update once per frame from
+//   the scene's Update() method. Systems that declare the component types
+//   they read and write (DeclareRead / DeclareWrite, usually in the
+//   constructor) can then run concurrently with non-conflicting systems:
+//
+//   MovementSystem() {
+//       DeclareRead <VelocityComponent>();
+//       DeclareWrite<TransformComponent>();
+//   }
+//
+//   A system that declares nothing is treated as exclusive: it never runs
+//   alongside another system. Systems that create / destroy entities or add /
+//   remove components must stay exclusive (or record the changes in their
+//   own CommandBuffer and flush it from an exclusive system).
 // ---------------------------------------------------------------------------
 
 class System {
@@ -44,12 +59,42 @@ public:
     // Optional: called on scene Unload to release GPU / physics resources.
     virtual void Shutdown(Registry& /*reg*/) {}
 
+    // Human-readable name used in SystemScheduler timing reports.
+    [[nodiscard]] virtual const char* Name() const { return "System"; }
+
     // Systems can be individually paused without removing them.
     void  SetEnabled(bool enabled) noexcept { m_enabled = enabled; }
     [[nodiscard]] bool IsEnabled() const noexcept { return m_enabled; }
 
+    // One declared component access.
+    struct Access {
+        ComponentTypeId type;
+        bool            write;
+        void          (*ensurePool)(Registry&); // creates the pool up front
+    };
+
+    // Declared accesses; empty means the system is exclusive.
+    [[nodiscard]] const std::vector<Access>& Accesses() const noexcept { return m_accesses; }
+    [[nodiscard]] bool IsExclusive() const noexcept { return m_accesses.empty(); }
+
+protected:
+    // Declare that Update reads the listed component types.
+    template<typename... Ts>
+    void DeclareRead()  { (AddAccess<Ts>(false), ...); }
+
+    // Declare that Update writes the listed component types.
+    template<typename... Ts>
+    void DeclareWrite() { (AddAccess<Ts>(true), ...); }
+
 private:
-    bool m_enabled = true;
+    template<typename T>
+    void AddAccess(bool write) {
+        m_accesses.push_back({ ComponentTypeOf<T>(), write,
+                               [](Registry& reg) { (void)reg.Pool<T>(); } });
+    }
+
+    bool                m_enabled = true;
+    std::vector<Access> m_accesses;
 };
 
 } // namespace Hotones::ECS
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <ECS/Registry.hpp>
+#include <ECS/System.hpp>
+#include <Jobs/JobPool.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// SystemScheduler — runs a set of Systems each frame, in parallel where the
+// declared component accesses allow it.
+//
+// Systems are ordered by registration. System B depends on an earlier
+// system A when either is exclusive or their accesses conflict (one writes a
+// component type the other reads or writes). Those edges form a DAG; every
+// system whose dependencies have finished is submitted to the JobPool, so
+// independent systems run at the same time while conflicting ones keep
+// their registration order — the result matches a serial run.
+//
+// Usage
+// -----
+//   SystemScheduler scheduler;
+//   scheduler.Emplace<MovementSystem>();
+//   scheduler.Emplace<LifetimeSystem>();
+//   scheduler.Init(reg);
+//
+//   // per frame
+//   scheduler.Update(reg, dt);
+//   for (const auto& t : scheduler.Timings())
+//       TraceLog(LOG_DEBUG, "%s %.3f ms", t.name, t.ms);
+// ---------------------------------------------------------------------------
+class SystemScheduler {
+public:
+    explicit SystemScheduler(Jobs::JobPool& jobs = Jobs::JobPool::Shared())
+        : m_jobs(&jobs) {}
+
+    SystemScheduler(const SystemScheduler&)            = delete;
+    SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+    // Take ownership of a system; it runs after every system added before it
+    // that it conflicts with.
+    System& Add(std::unique_ptr<System> system) {
+        m_nodes.push_back({ std::move(system), {}, 0, 0.0 });
+        m_dirty = true;
+        return *m_nodes.back().system;
+    }
+
+    template<typename S, typename... Args>
+    S& Emplace(Args&&... args) {
+        return static_cast<S&>(Add(std::make_unique<S>(std::forward<Args>(args)...)));
+    }
+
+    [[nodiscard]] size_t Size() const noexcept { return m_nodes.size(); }
+
+    // Forward to System::Init / System::Shutdown in registration order.
+    void Init(Registry& reg) {
+        for (auto& n : m_nodes) n.system->Init(reg);
+    }
+    void Shutdown(Registry& reg) {
+        for (auto& n : m_nodes) n.system->Shutdown(reg);
+    }
+
+    // Run every enabled system once. Blocks until all of them have finished,
+    // so do not call it from a job running on the scheduler's own JobPool.
+    void Update(Registry& reg, float dt) {
+        if (m_nodes.empty()) return;
+        if (m_dirty) Rebuild();
+
+        // Pools are created lazily by the Registry; create every declared
+        // one now so concurrent systems never grow the pool table.
+        for (auto& n : m_nodes)
+            for (const auto& a : n.system->Accesses()) a.ensurePool(reg);
+
+        if (m_jobs->WorkerCount() == 0) {
+            for (size_t i = 0; i < m_nodes.size(); ++i) RunNode(i, reg, dt);
+        } else {
+            RunGraph(reg, dt);
+        }
+
+        m_timings.clear();
+        m_timings.reserve(m_nodes.size());
+        for (const auto& n : m_nodes) m_timings.push_back({ n.system->Name(), n.ms });
+    }
+
+    // Per-system wall time of the last Update, in registration order.
+    // Disabled systems report 0.
+    struct Timing {
+        const char* name;
+        double      ms;
+    };
+    [[nodiscard]] const std::vector<Timing>& Timings() const noexcept { return m_timings; }
+
+private:
+    struct Node {
+        std::unique_ptr<System> system;
+        std::vector<size_t>     dependents;  // nodes that wait for this one
+        size_t                  depCount;    // number of nodes this one waits for
+        double                  ms;          // last Update duration
+    };
+
+    [[nodiscard]] static bool Conflicts(const System& a, const System& b) {
+        if (a.IsExclusive() || b.IsExclusive()) return true;
+        for (const auto& x : a.Accesses())
+            for (const auto& y : b.Accesses())
+                if (x.type == y.type && (x.write || y.write)) return true;
+        return false;
+    }
+
+    void Rebuild() {
+        for (auto& n : m_nodes) { n.dependents.clear(); n.depCount = 0; }
+        for (size_t j = 0; j < m_nodes.size(); ++j) {
+            for (size_t i = 0; i < j; ++i) {
+                if (!Conflicts(*m_nodes[i].system, *m_nodes[j].system)) continue;
+                m_nodes[i].dependents.push_back(j);
+                ++m_nodes[j].depCount;
+            }
+        }
+        m_dirty = false;
+    }
+
+    void RunNode(size_t i, Registry& reg, float dt) {
+        Node& n = m_nodes[i];
+        if (!n.system->IsEnabled()) { n.ms = 0.0; return; }
+        const auto t0 = std::chrono::steady_clock::now();
+        n.system->Update(reg, dt);
+        const auto t1 = std::chrono::steady_clock::now();
+        n.ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    }
+
+    // Completion state of one RunGraph call. Shared with every node job so
+    // a job that is still signalling after the waiter has woken (and
+    // returned) never touches a destroyed mutex or counter.
+    struct GraphRun {
+        explicit GraphRun(size_t nodes) : pending(nodes), remaining(nodes) {}
+
+        Registry*                        reg = nullptr;
+        float                            dt  = 0.f;
+        std::vector<std::atomic<size_t>> pending;    // unfinished dependencies per node
+        size_t                           remaining;  // guarded by mutex
+        std::mutex                       mutex;
+        std::condition_variable          cv;
+    };
+
+    void Launch(const std::shared_ptr<GraphRun>& run, size_t i) {
+        m_jobs->Submit([this, run, i] { RunGraphNode(run, i); });
+    }
+
+    // Runs node i, then submits every dependent whose last unfinished
+    // dependency this was.
+    void RunGraphNode(const std::shared_ptr<GraphRun>& run, size_t i) {
+        RunNode(i, *run->reg, run->dt);
+        for (size_t d : m_nodes[i].dependents)
+            if (run->pending[d].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                Launch(run, d);
+        std::lock_guard<std::mutex> lk(run->mutex);
+        if (--run->remaining == 0) run->cv.notify_all();
+    }
+
+    void RunGraph(Registry& reg, float dt) {
+        auto run = std::make_shared<GraphRun>(m_nodes.size());
+        run->reg = &reg;
+        run->dt  = dt;
+        for (size_t i = 0; i < m_nodes.size(); ++i)
+            run->pending[i].store(m_nodes[i].depCount, std::memory_order_relaxed);
+
+        for (size_t i = 0; i < m_nodes.size(); ++i)
+            if (m_nodes[i].depCount == 0) Launch(run, i);
+
+        std::unique_lock<std::mutex> lk(run->mutex);
+        run->cv.wait(lk, [&] { return run->remaining == 0; });
+    }
+
+    Jobs::JobPool*      m_jobs;
+    std::vector<Node>   m_nodes;
+    std::vector<Timing> m_timings;
+    bool                m_dirty = false;
+};
+
+} // namespace Hotones::ECS
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <ECS/Components.hpp>
+#include <ECS/Hierarchy.hpp>
+#include <ECS/KinematicPool.hpp>
+#include <ECS/Registry.hpp>
+#include <ECS/System.hpp>
+#include <Jobs/JobPool.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// Systems.hpp — built-in engine systems.
+//
+// Each one is a plain System and can be added to a SystemScheduler or
+// updated by hand from a scene.
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+// KinematicSystem — moves every KinematicComponent by its velocity and
+// destroys the entities whose lifetime ran out.
+//
+// The SIMD kernel (KinematicPool::Integrate) runs in chunks of `grain`
+// dense slots on a Jobs::JobPool; expired entities are collected per chunk
+// and destroyed in one DestroyEntities batch after every chunk finished.
+//
+// Exclusive (declares no accesses) because it destroys entities.
+// ---------------------------------------------------------------------------
+class KinematicSystem : public System {
+public:
+    explicit KinematicSystem(Jobs::JobPool& jobs = Jobs::JobPool::Shared(), size_t grain = 16384)
+        : m_jobs(&jobs), m_grain(grain < 64 ? 64 : grain) {}
+
+    void Update(Registry& reg, float dt) override {
+        m_dead.clear();
+        auto& pool = reg.Pool<KinematicComponent>();
+        const size_t count = pool.Size();
+        if (count == 0) return;
+
+        const size_t chunks = (count + m_grain - 1) / m_grain;
+        if (m_expired.size() < chunks) m_expired.resize(chunks);
+        for (size_t c = 0; c < chunks; ++c) m_expired[c].clear();
+
+        m_jobs->ParallelFor(count, m_grain, [&](size_t begin, size_t end) {
+            pool.Integrate(begin, end, dt, m_expired[begin / m_grain]);
+        });
+
+        for (size_t c = 0; c < chunks; ++c)
+            for (const uint32_t idx : m_expired[c]) m_dead.push_back(reg.EntityAt(idx));
+        if (!m_dead.empty()) reg.DestroyEntities(m_dead);
+    }
+
+    // Entities destroyed by the last Update (no longer alive).
+    [[nodiscard]] std::span<const EntityId> Expired() const noexcept { return m_dead; }
+
+    [[nodiscard]] const char* Name() const override { return "KinematicSystem"; }
+
+private:
+    Jobs::JobPool*                     m_jobs;
+    size_t                             m_grain;    // dense slots per job
+    std::vector<std::vector<uint32_t>> m_expired;  // per-chunk entity indices
+    std::vector<EntityId>              m_dead;
+};
+
+// ---------------------------------------------------------------------------
+// LifetimeSystem — counts every LifetimeComponent down by dt and destroys
+// the entities whose time ran out, in one DestroyEntities batch.
+//
+// The ids destroyed by the last Update stay available through Expired()
+// until the next one, e.g. to hand the whole frame's list to Lua at once
+// (CupLoader::fireEntitiesExpired) instead of one callback per entity.
+//
+// Exclusive (declares no accesses) because it destroys entities.
+// ---------------------------------------------------------------------------
+class LifetimeSystem : public System {
+public:
+    void Update(Registry& reg, float dt) override {
+        m_expired.clear();
+        auto& pool = reg.Pool<LifetimeComponent>();
+        const size_t count = pool.Size();
+        if (count == 0) return;
+
+        // Every slot is written below; mark them in one pass.
+        pool.MarkChanged(0, count);
+        auto&       data    = pool.Components();
+        const auto& indices = pool.EntityIndices();
+        for (size_t i = 0; i < count; ++i) {
+            float& remaining = data[i].remaining;
+            remaining -= dt;
+            if (remaining <= 0.0f) m_expired.push_back(reg.EntityAt(indices[i]));
+        }
+        if (!m_expired.empty()) reg.DestroyEntities(m_expired);
+    }
+
+    // Entities destroyed by the last Update (no longer alive).
+    [[nodiscard]] std::span<const EntityId> Expired() const noexcept { return m_expired; }
+
+    [[nodiscard]] const char* Name() const override { return "LifetimeSystem"; }
+
+private:
+    std::vector<EntityId> m_expired;
+};
+
+// ---------------------------------------------------------------------------
+// DeathSystem — finds the entities whose HealthComponent dropped to zero.
+//
+// Only health components changed since the previous Update are examined
+// (Changed<> filter), so a steady world costs one tick compare per
+// component. Entities are reported, not destroyed: what death means
+// (ragdoll, respawn, loot drop) is up to the game. Died() holds the list
+// until the next Update.
+//
+// Run it after the tick's last health write (e.g. at the end of the
+// frame): writes made later in the same tick are not seen by the next
+// Update either.
+// ---------------------------------------------------------------------------
+class DeathSystem : public System {
+public:
+    DeathSystem() { DeclareRead<HealthComponent>(); }
+
+    void Update(Registry& reg, float /*dt*/) override {
+        m_died.clear();
+        const uint32_t since = m_since;
+        m_since = reg.CurrentTick() + 1;
+        reg.Each<Changed<const HealthComponent>>(since, [&](EntityId id, const HealthComponent& h) {
+            if (h.isDead()) m_died.push_back(id);
+        });
+    }
+
+    // Entities found dead by the last Update.
+    [[nodiscard]] std::span<const EntityId> Died() const noexcept { return m_died; }
+
+    [[nodiscard]] const char* Name() const override { return "DeathSystem"; }
+
+private:
+    std::vector<EntityId> m_died;
+    uint32_t              m_since = 0;  // first tick not yet examined
+};
+
+// ---------------------------------------------------------------------------
+// TransformHierarchySystem — fills WorldTransformComponent from the local
+// TransformComponents along each entity's ParentComponent chain.
+//
+// Parented entities are kept in a list sorted by depth (then by parent, so
+// siblings sit next to each other); one pass over it visits every parent
+// before its children. The list is rebuilt only when a ParentComponent is
+// added, removed or changed. Each entry caches its own and its parent's
+// dense slots in the Transform / WorldTransform pools and checks them with
+// one read of the pool's entity array, so unless an add / remove moved
+// them the pass does no sparse-set lookups.
+//
+// Only dirty subtrees are recomputed: an entity's world matrix is rebuilt
+// when its own Transform changed since the previous Update, or its
+// parent's world matrix was rebuilt in this one. Roots — WorldTransform
+// but no live parent — get world = local.
+//
+// Run it after the tick's last Transform / hierarchy change (e.g. at the
+// end of the frame, before drawing): changes made later in the same tick
+// are not seen by the next Update either.
+// ---------------------------------------------------------------------------
+class TransformHierarchySystem : public System {
+public:
+    TransformHierarchySystem() {
+        DeclareRead <TransformComponent, ParentComponent>();
+        DeclareWrite<WorldTransformComponent, ChildrenComponent>();
+    }
+
+    void Update(Registry& reg, float /*dt*/) override {
+        const uint32_t since = m_since;
+        m_since = reg.CurrentTick() + 1;
+
+        auto& parents = reg.Pool<ParentComponent>();
+        auto& locals  = reg.Pool<TransformComponent>();
+        auto& worlds  = reg.Pool<WorldTransformComponent>();
+        if (ParentsChanged(parents, since)) Rebuild(reg, parents);
+        ++m_pass;
+
+        // Roots.
+        const auto& worldIdx = worlds.EntityIndices();
+        for (size_t i = 0; i < worldIdx.size(); ++i) {
+            const uint32_t idx = worldIdx[i];
+            if (parents.Has(idx) || !locals.Has(idx)) continue;
+            const uint32_t slot = locals.Index(idx);
+            if (!m_full && locals.ChangedTick(slot) < since) continue;
+            worlds.MarkChanged(i);
+            worlds.Components()[i].matrix = std::as_const(locals).Components()[slot].ToMatrix();
+            Stamp(idx);
+        }
+
+        // Children, parents first.
+        for (Node& n : m_order) {
+            const uint32_t slot  = Slot(locals, n.idx, n.localSlot);
+            const uint32_t world = Slot(worlds, n.idx, n.worldSlot);
+            if (slot == NO_SLOT || world == NO_SLOT) continue;
+            const uint32_t parentIdx   = EntityIndex(n.parent);
+            const uint32_t parentWorld = reg.IsAlive(n.parent) ? Slot(worlds, parentIdx, n.parentSlot) : NO_SLOT;
+            const bool     attached    = parentWorld != NO_SLOT;
+
+            bool dirty = m_full || locals.ChangedTick(slot) >= since || attached == n.orphan;
+            if (attached && !dirty) dirty = parentIdx < m_stamp.size() && m_stamp[parentIdx] == m_pass;
+            n.orphan = !attached;
+            if (!dirty) continue;
+
+            const Matrix local = std::as_const(locals).Components()[slot].ToMatrix();
+            worlds.MarkChanged(world);
+            worlds.Components()[world].matrix = attached
+                ? MatrixMultiply(local, std::as_const(worlds).Components()[parentWorld].matrix)
+                : local;
+            Stamp(n.idx);
+        }
+        m_full = false;
+    }
+
+    [[nodiscard]] const char* Name() const override { return "TransformHierarchySystem"; }
+
+private:
+    static constexpr uint32_t NO_SLOT = ~0u;
+
+    struct Node {
+        uint32_t idx;     // entity index of the child
+        EntityId parent;
+        uint32_t depth;   // 1 = child of a root
+        bool     orphan;  // parent was dead / detached on the last pass
+        // Last known dense slots (NO_SLOT: absent / not looked up yet).
+        uint32_t localSlot  = NO_SLOT;   // child's Transform
+        uint32_t worldSlot  = NO_SLOT;   // child's WorldTransform
+        uint32_t parentSlot = NO_SLOT;   // parent's WorldTransform
+    };
+
+    // Dense slot of entity index idx in pool, or NO_SLOT. Tries cached
+    // first (one read of the entity array) and refreshes it with a sparse
+    // lookup only when the component has moved.
+    template<typename PoolT>
+    static uint32_t Slot(const PoolT& pool, uint32_t idx, uint32_t& cached) {
+        const auto& dense = pool.EntityIndices();
+        if (cached < dense.size() && dense[cached] == idx) return cached;
+        cached = pool.Has(idx) ? pool.Index(idx) : NO_SLOT;
+        return cached;
+    }
+
+    // True if a ParentComponent was added, removed or written since `since`.
+    bool ParentsChanged(const PoolOf<ParentComponent>& parents, uint32_t since) {
+        bool changed = parents.Size() != m_parentCount;
+        for (size_t i = 0; !changed && i < parents.Size(); ++i)
+            changed = parents.ChangedTick(i) >= since;
+        m_parentCount = parents.Size();
+        return changed;
+    }
+
+    // Re-sort the parented entities by depth and drop stale entries from
+    // every ChildrenComponent. The next pass recomputes every world matrix.
+    void Rebuild(Registry& reg, const PoolOf<ParentComponent>& parents) {
+        const auto& indices = parents.EntityIndices();
+
+        m_order.clear();
+        m_order.reserve(indices.size());
+        for (size_t i = 0; i < indices.size(); ++i) {
+            const EntityId parent = parents.Components()[i].parent;
+            uint32_t depth = 1;
+            for (EntityId e = parent; depth <= indices.size(); ++depth) {
+                const EntityId up = reg.IsAlive(e) ? ParentOf(reg, e) : INVALID_ENTITY;
+                if (up == INVALID_ENTITY) break;
+                e = up;
+            }
+            m_order.push_back({ indices[i], parent, depth, false });
+        }
+        std::sort(m_order.begin(), m_order.end(), [](const Node& a, const Node& b) {
+            return a.depth != b.depth ? a.depth < b.depth : a.parent < b.parent;
+        });
+
+        reg.Each<ChildrenComponent>([&](EntityId id, ChildrenComponent& c) {
+            std::erase_if(c.children, [&](EntityId child) { return ParentOf(reg, child) != id; });
+        });
+        m_full = true;
+    }
+
+    void Stamp(uint32_t idx) {
+        if (idx >= m_stamp.size()) m_stamp.resize(idx + 1, 0u);
+        m_stamp[idx] = m_pass;
+    }
+
+    std::vector<Node>     m_order;             // parented entities, by depth
+    std::vector<uint32_t> m_stamp;             // per entity index: pass its world was rebuilt
+    uint32_t              m_pass        = 0;
+    uint32_t              m_since       = 0;   // first tick not yet examined
+    size_t                m_parentCount = 0;
+    bool                  m_full        = true; // recompute everything next pass
+};
+
+} // namespace Hotones::ECS
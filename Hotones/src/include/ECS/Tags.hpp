@@ -0,0 +1,99 @@
+#pragma once
+
+#include <ECS/Entity.hpp>
+#include <ECS/Registry.hpp>
+#include <ECS/Components.hpp>
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Hotones::ECS {
+
+// ---------------------------------------------------------------------------
+// Tags.hpp — name → entity index over TagComponent.
+//
+//   reg.SetTag(boss, "Boss");
+//   ...
+//   EntityId b = reg.FindByTag("Boss");     // hash lookup, no pool scan
+//
+// The index always holds exactly the live entities that own a TagComponent:
+// AddComponent<TagComponent>, SetTag, Instantiate and Deserialize add them,
+// RemoveComponent<TagComponent> and destroying the entity take them out.
+// Each entity remembers its position in its bucket, so every update is O(1)
+// on average and lookups never skip stale entries.
+//
+// Rename through SetTag. Assigning TagComponent::name directly is not seen
+// by the index until the next RebuildTagIndex.
+// ---------------------------------------------------------------------------
+
+inline void Registry::IndexTag(std::string_view name, std::span<const EntityId> ids) {
+    auto it = m_tagIndex.find(name);
+    if (it == m_tagIndex.end()) {
+        it = m_tagIndex.emplace(std::string(name), TagBucket{}).first;
+        it->second.name = &it->first;
+    }
+    TagBucket& bucket = it->second;
+    if (m_tagSlots.size() < m_generations.size()) m_tagSlots.resize(m_generations.size());
+    if (ids.size() > 1) bucket.ids.reserve(bucket.ids.size() + ids.size());
+    for (const EntityId id : ids) {
+        m_tagSlots[EntityIndex(id)] = { &bucket, static_cast<uint32_t>(bucket.ids.size()) };
+        bucket.ids.push_back(id);
+    }
+}
+
+inline void Registry::UnindexTag(uint32_t idx) {
+    if (idx >= m_tagSlots.size() || !m_tagSlots[idx].bucket) return;
+    TagBucket&     bucket = *m_tagSlots[idx].bucket;
+    const uint32_t pos    = m_tagSlots[idx].pos;
+    const EntityId last   = bucket.ids.back();
+    bucket.ids[pos]                   = last;
+    m_tagSlots[EntityIndex(last)].pos = pos;
+    bucket.ids.pop_back();
+    m_tagSlots[idx].bucket = nullptr;
+    if (bucket.ids.empty()) m_tagIndex.erase(m_tagIndex.find(std::string_view(*bucket.name)));
+}
+
+inline void Registry::SetTag(EntityId id, std::string_view name) {
+    if (!IsAlive(id)) return;
+    auto* tag = TryGetComponent<TagComponent>(id);
+    if (!tag) {
+        AddComponent<TagComponent>(id, TagComponent{ std::string(name) });
+        return;
+    }
+    const uint32_t idx = EntityIndex(id);
+    if (tag->name == name && idx < m_tagSlots.size() && m_tagSlots[idx].bucket &&
+        *m_tagSlots[idx].bucket->name == name)
+        return;
+    UnindexTag(idx);
+    tag->name.assign(name);
+    IndexTag(tag->name, std::span<const EntityId>(&id, 1));
+}
+
+inline EntityId Registry::FindByTag(std::string_view name) const {
+    const auto it = m_tagIndex.find(name);
+    return it == m_tagIndex.end() ? INVALID_ENTITY : it->second.ids.front();
+}
+
+inline size_t Registry::FindAllByTag(std::string_view name, std::vector<EntityId>& out) const {
+    const std::span<const EntityId> ids = Tagged(name);
+    out.insert(out.end(), ids.begin(), ids.end());
+    return ids.size();
+}
+
+inline std::span<const EntityId> Registry::Tagged(std::string_view name) const {
+    const auto it = m_tagIndex.find(name);
+    if (it == m_tagIndex.end()) return {};
+    return it->second.ids;
+}
+
+inline void Registry::RebuildTagIndex() {
+    m_tagIndex.clear();
+    m_tagSlots.clear();
+    Each<const TagComponent>([this](EntityId id, const TagComponent& tag) {
+        IndexTag(tag.name, std::span<const EntityId>(&id, 1));
+    });
+}
+
+} // namespace Hotones::ECS
@@ -26,6 +26,11 @@ public:
     // `hitPos` (position at impact), `hitNormal` (surface normal), and `t` (0..1 param along segment).
     bool SweepSphere(const Vector3 &start, const Vector3 &end, float radius, Vector3 &hitPos, Vector3 &hitNormal, float &t);
 
+    // True once the collision mesh can be queried (its BVH is built in the
+    // background after construction). Also true if registration failed, as
+    // there is then nothing to wait for.
+    bool IsCollisionReady() const;
+
     // Apply a custom shader to all materials in this model (e.g. lit shader).
     void SetShader(Shader shader);
 
@@ -3,7 +3,9 @@
 #include <GFX/Scene.hpp>
 #include <GFX/Player.hpp>
 #include <ECS/Registry.hpp>
+#include <ECS/Systems.hpp>
 #include <memory>
+#include <vector>
 #include <raylib.h>
 
 // Forward declarations
@@ -48,6 +50,11 @@ private:
     std::shared_ptr<CollidableModel> m_world;
     Net::NetworkManager*             m_netMgr   = nullptr;
     ECS::Registry                    m_registry;   ///< ECS world for this scene
+    ECS::KinematicSystem             m_kinematics; ///< SIMD integration of KinematicComponent
+    ECS::LifetimeSystem              m_lifetimes;  ///< LifetimeComponent countdown + despawn
+    ECS::DeathSystem                 m_deaths;     ///< HealthComponent reaching zero
+    ECS::TransformHierarchySystem    m_hierarchy;  ///< WorldTransform from parent chains
+    std::vector<ECS::EntityId>       m_expired;    ///< this frame's despawns, handed to Lua
 
     void DrawFallbackGround() const;
 };
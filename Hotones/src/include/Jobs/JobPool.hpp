@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Hotones::Jobs {
+
+// ---------------------------------------------------------------------------
+// JobPool — fixed set of worker threads draining a FIFO job queue.
+//
+// Submit      fire-and-forget job
+// ParallelFor split [0, count) into grain-sized chunks and run them on the
+//             workers AND the calling thread; returns when every chunk has
+//             finished. Safe to call from inside a job (the caller keeps
+//             claiming chunks itself, so it never waits on a queued helper).
+//             Its helpers go to the front of the queue: work already in
+//             flight finishes before queued jobs start.
+//
+// Shared() is a process-wide pool sized to the machine (one thread per core
+// minus the caller). Create a dedicated JobPool if work must not compete
+// with other Shared() users.
+// ---------------------------------------------------------------------------
+class JobPool {
+public:
+    explicit JobPool(unsigned workerCount = DefaultWorkerCount()) {
+        m_workers.reserve(workerCount);
+        for (unsigned i = 0; i < workerCount; ++i)
+            m_workers.emplace_back([this] { WorkerLoop(); });
+    }
+
+    ~JobPool() {
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_running = false;
+        }
+        m_cv.notify_all();
+        for (auto& t : m_workers)
+            if (t.joinable()) t.join();
+    }
+
+    JobPool(const JobPool&)            = delete;
+    JobPool& operator=(const JobPool&) = delete;
+
+    [[nodiscard]] unsigned WorkerCount() const noexcept {
+        return static_cast<unsigned>(m_workers.size());
+    }
+
+    // Queue a job to run on a worker thread.
+    void Submit(std::function<void()> job) {
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_queue.push_back(std::move(job));
+        }
+        m_cv.notify_one();
+    }
+
+    // Calls fn(begin, end) for consecutive chunks of at most `grain` items
+    // covering [0, count). Chunks run concurrently; blocks until all are done.
+    template<typename Fn>
+    void ParallelFor(size_t count, size_t grain, Fn&& fn) {
+        if (count == 0) return;
+        grain = std::max<size_t>(grain, 1);
+        const size_t chunks = (count + grain - 1) / grain;
+
+        if (chunks == 1 || m_workers.empty()) {
+            fn(size_t(0), count);
+            return;
+        }
+
+        // Shared with the helpers: a helper that only starts after every
+        // chunk was claimed must still be able to touch the state safely.
+        struct State {
+            std::atomic<size_t>     next{ 0 };
+            std::atomic<size_t>     done{ 0 };
+            std::mutex              mutex;
+            std::condition_variable cv;
+        };
+        auto state = std::make_shared<State>();
+
+        // Claims and runs chunks until none are left. fn is only touched
+        // while a chunk is claimed, i.e. while the caller is still waiting.
+        auto drain = [state, count, grain, chunks, &fn] {
+            for (;;) {
+                const size_t chunk = state->next.fetch_add(1, std::memory_order_relaxed);
+                if (chunk >= chunks) return;
+                const size_t begin = chunk * grain;
+                fn(begin, std::min(begin + grain, count));
+                if (state->done.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks) {
+                    std::lock_guard<std::mutex> lk(state->mutex);
+                    state->cv.notify_all();
+                }
+            }
+        };
+
+        const size_t helpers = std::min<size_t>(m_workers.size(), chunks - 1);
+        for (size_t i = 0; i < helpers; ++i) SubmitFront(drain);
+        drain();
+
+        std::unique_lock<std::mutex> lk(state->mutex);
+        state->cv.wait(lk, [&] { return state->done.load(std::memory_order_acquire) == chunks; });
+    }
+
+    // Process-wide pool shared by the ECS and other engine subsystems.
+    [[nodiscard]] static JobPool& Shared() {
+        static JobPool s_pool;
+        return s_pool;
+    }
+
+    [[nodiscard]] static unsigned DefaultWorkerCount() noexcept {
+        const unsigned hw = std::thread::hardware_concurrency();
+        return hw > 1 ? hw - 1 : 1;
+    }
+
+private:
+    void SubmitFront(std::function<void()> job) {
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_queue.push_front(std::move(job));
+        }
+        m_cv.notify_one();
+    }
+
+    void WorkerLoop() {
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lk(m_mutex);
+                m_cv.wait(lk, [this] { return !m_queue.empty() || !m_running; });
+                if (!m_running && m_queue.empty()) return;
+                job = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+            job();
+        }
+    }
+
+    std::vector<std::thread>          m_workers;
+    std::deque<std::function<void()>> m_queue;
+    std::mutex                        m_mutex;
+    std::condition_variable           m_cv;
+    bool                              m_running = true;
+};
+
+} // namespace Hotones::Jobs
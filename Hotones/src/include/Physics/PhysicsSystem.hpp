@@ -9,9 +9,29 @@ void ShutdownPhysics();
 
 // Register a static (non-moving) collision mesh built from a raylib `Model`.
 // Returns a positive handle id on success, or -1 if registration failed / not available.
+// The mesh's BVH is built in the background (on the calling thread if
+// InitPhysics has not been called); until it is ready, queries against the
+// handle return false.
+// Up to 4096 meshes can be registered at once.
 int RegisterStaticMeshFromModel(const Model& model, const Vector3& position);
+// The handle becomes invalid immediately (even if its slot is later reused);
+// queries already running against it finish on the old mesh.
 void UnregisterStaticMesh(int handle);
 
+// True once handle's BVH has been built and queries against it can hit.
+bool IsMeshReady(int handle);
+
+// Number of registered meshes whose BVH is still being built (e.g. for a
+// loading-screen progress bar).
+int PendingBuildCount();
+
+// Block until every queued BVH build has finished. Call before spawning
+// players into a freshly loaded level so nothing falls through the floor.
+void WaitForPendingBuilds();
+
+// Queries below may be called from any number of threads at once, including
+// while meshes are being registered or unregistered; they never take a lock.
+
 // Continuous sphere sweep against a registered static mesh.
 // start/end are sphere center positions. Returns true if hit; t ∈ [0,1].
 bool SweepSphereAgainstStatic(int handle, const Vector3& start, const Vector3& end,
@@ -31,4 +51,36 @@ bool RaycastAgainstStatic(int handle, const Vector3& origin, const Vector3& dir,
                            float maxDist,
                            Vector3& hitPos, Vector3& hitNormal, float& t);
 
+// ── Batched queries ─────────────────────────────────────────────────────────
+// Answer many queries against one mesh in a single call: the mesh is looked
+// up once, and runs of four consecutive queries heading the same way share
+// one traversal. Put related rays (shotgun pellets, a fan of line-of-sight
+// checks) next to each other to benefit.
+
+struct RayQuery {
+    Vector3 origin  = { 0, 0, 0 };
+    Vector3 dir     = { 0, 0, 1 };   // need not be normalised
+    float   maxDist = 1000.f;
+};
+
+struct SweepQuery {
+    Vector3 start  = { 0, 0, 0 };    // sphere center positions
+    Vector3 end    = { 0, 0, 0 };
+    float   radius = 0.f;
+};
+
+// One query's result. pos / normal / t are only meaningful when hit is set;
+// t follows the single-query function's convention.
+struct QueryHit {
+    bool    hit    = false;
+    Vector3 pos    = { 0, 0, 0 };
+    Vector3 normal = { 0, 1, 0 };
+    float   t      = 0.f;
+};
+
+// hits[i] receives the result of rays[i] / sweeps[i]. Returns the number of
+// queries that hit (0 if the handle is unknown or not ready yet).
+int RaycastBatch(int handle, const RayQuery* rays, int count, QueryHit* hits);
+int SweepSphereBatch(int handle, const SweepQuery* sweeps, int count, QueryHit* hits);
+
 }} // namespace Hotones::Physics
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 #include <string>
 #include <atomic>
 
@@ -54,6 +55,15 @@ public:
     // Call MainClass:onPlayerLeft(id) if the method exists.
     void firePlayerLeft(uint8_t id);
 
+    // ── ECS event hooks ───────────────────────────────────────────────────────
+    // Each delivers a whole frame's entity ids as ONE array argument, and
+    // does nothing if the list is empty or the method does not exist.
+    // Call MainClass:onEntitiesExpired(ids) — entities the lifetime system
+    // destroyed this frame (already dead when the method runs).
+    void fireEntitiesExpired(std::span<const uint32_t> ids);
+    // Call MainClass:onEntitiesDied(ids) — entities whose health reached zero.
+    void fireEntitiesDied(std::span<const uint32_t> ids);
+
     // Path declared in Init.MainScene, resolved to an absolute path.
     // Empty string if none was declared or loadPak has not been called.
     const std::string& mainScenePath() const { return m_mainScene; }
@@ -87,6 +97,10 @@ private:
     // nargs = number of extra arguments above the implicit `self`.
     bool callMethod(const char* method, int nargs = 0);
 
+    // Call MainClass:<method>(ids) with ids as a Lua array, if non-empty and
+    // the method exists.
+    void fireEntityList(const char* method, std::span<const uint32_t> ids);
+
     lua_State*             L;
     std::string            m_mainScene;
     std::string            m_initPath;    ///< absolute path to last loaded init.lua
@@ -19,6 +19,10 @@ void setECSRegistry(ECS::Registry* reg);
 /// engine player controller.  Mirrors the LocalPlayer library's pointer.
 void setECSLocalPlayer(Player* player);
 
+/// Mark whether the registry was restored from a snapshot (server warm
+/// start) so the pack's Init can skip building the world; see ecs.isRestored.
+void setECSRestored(bool restored);
+
 // ── Registration ─────────────────────────────────────────────────────────────
 /// Register the `ecs` global table into the given Lua state.
 ///
@@ -27,6 +31,7 @@ void setECSLocalPlayer(Player* player);
 ///   ecs.create()                    → id          -- spawn a blank entity
 ///   ecs.destroy(id)                               -- destroy + strip all components
 ///   ecs.isAlive(id)                 → bool
+///   ecs.isRestored()                → bool        -- world came from a snapshot
 ///
 /// Transform  (auto-created on first setPos / setScale / setVelocity)
 /// ---------
@@ -40,6 +45,8 @@ void setECSLocalPlayer(Player* player);
 /// ---
 ///   ecs.setTag(id, name)
 ///   ecs.getTag(id)                  → string (or "")
+///   ecs.findByTag(name)             → id (or nil)
+///   ecs.findAllByTag(name)          → { id, ... }
 ///
 /// Health
 /// ------
@@ -60,6 +67,29 @@ void setECSLocalPlayer(Player* player);
 ///   ecs.hasPlayer(id)               → bool
 ///   ecs.removePlayer(id)
 ///   ecs.setPlayerBhop(id, enabled)  -- toggle Source-style bhop
+///
+/// Hierarchy  (a child's Transform is relative to its parent)
+/// ---------
+///   ecs.setParent(id, parent|nil)   → bool        -- false on dead ids / cycles
+///   ecs.getParent(id)               → id | nil
+///   ecs.getWorldPos(id)             → x, y, z     -- composed world position
+///
+/// Bulk queries  (components: "Transform", "Velocity", "Health", "Lifetime")
+/// ------------
+///   ecs.query(comps)                → batch       -- every match, as parallel arrays
+///   ecs.query(comps, fn[, size])                  -- fn(batch) per batch; fields written back
+///   ecs.each(comps, fn)                           -- fn(id, fields...) → new leading fields
+///   ecs.update(comps, batch)                      -- write a batch back
+///
+/// Component references
+/// --------------------
+///   ecs.ref(id, comp)               → ref | nil   -- ref.<field> reads/writes in place;
+///                                                    ref.valid false once stale
+///
+/// Prefabs  (def: { Transform = {x=,y=,z=}, Velocity = {...}, Tag = "name", ... })
+/// -------
+///   ecs.prefab(def)                 → prefab
+///   ecs.spawnPrefab(prefab|def[, n]) → { id, ... }  -- n entities in one bulk spawn
 void registerECS(lua_State* L);
 
 } // namespace Hotones::Scripting::LuaLoader
@@ -7,10 +7,15 @@ namespace Hotones {
 // Run a headless (no-window) dedicated game server.
 // Blocks until SIGINT / SIGTERM is received.
 //
-// port    – UDP port to listen on (default 27015)
-// pakPath – path to a .cup archive or an extracted directory; if non-empty
-//           the pack's Lua :Update() is called every server tick.
-void RunHeadlessServer(uint16_t           port    = 27015,
-                       const std::string& pakPath = {});
+// port         – UDP port to listen on (default 27015)
+// pakPath      – path to a .cup archive or an extracted directory; if non-empty
+//                the pack's Lua :Update() is called every server tick.
+// snapshotPath – if non-empty, the server's ECS world is restored from this
+//                file on start (when it exists, before the pack's Init runs —
+//                see ecs.isRestored) and checkpointed back to it periodically
+//                and on shutdown (see ECS/Snapshot.hpp).
+void RunHeadlessServer(uint16_t           port         = 27015,
+                       const std::string& pakPath      = {},
+                       const std::string& snapshotPath = {});
 
 } // namespace Hotones
@@ -47,6 +47,7 @@ int main(int argc, char** argv)
     uint16_t    connectPort = Hotones::Net::DEFAULT_PORT;
     std::string playerName  = "Player";
     std::string pakPath;
+    std::string snapshotPath;
 
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
@@ -62,6 +63,8 @@ int main(int argc, char** argv)
             playerName = argv[++i];
         } else if (arg == "--pak" && i + 1 < argc) {
             pakPath = argv[++i];
+        } else if (arg == "--snapshot" && i + 1 < argc) {
+            snapshotPath = argv[++i];
         }
     }
     TraceLog(LOG_DEBUG, "CLI args: isServer=%d serverPort=%d connectHost=%s connectPort=%d playerName=%s pak=%s",
@@ -73,7 +76,7 @@ int main(int argc, char** argv)
     if (__startup_log) __startup_log << "args parsed\n";
     // ── Headless server mode (no window needed) ─────────────────────────────
     if (isServer) {
-        Hotones::RunHeadlessServer(serverPort, pakPath);
+        Hotones::RunHeadlessServer(serverPort, pakPath, snapshotPath);
         return 0;
     }
     // Initialization